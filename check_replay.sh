@@ -0,0 +1,46 @@
+#!/bin/bash
+
+# Bloodstrike 2D - Record/Replay Check
+# Records a short headless game for each start action, both started straight
+# away and after waiting at the menu, replays it and checks that every tick's
+# state hash matches the recording
+
+set -e  # Exit on any error
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+cd "$SCRIPT_DIR"
+
+GAME="${1:-./build/Bloodstrike}"
+TICKS="${TICKS:-1500}"
+SEED="${SEED:-7}"
+
+if [ ! -x "$GAME" ]; then
+    echo "❌ $GAME not found; build first (./run.sh) or pass the binary path"
+    exit 1
+fi
+
+WORK_DIR="$(mktemp -d)"
+trap 'rm -rf "$WORK_DIR"' EXIT
+
+MENU_FRAMES="${MENU_FRAMES:-120}"
+
+failed=0
+for action in singleplayer dualplayer; do
+    for menuFrames in 0 "$MENU_FRAMES"; do
+        name="$action-after-$menuFrames"
+        recording="$WORK_DIR/$name.rec"
+        "$GAME" --headless --start "$action" --start-after "$menuFrames" --seed "$SEED" \
+            --ticks "$((TICKS + menuFrames))" --record "$recording" --hash-log "$WORK_DIR/$name.recorded" > /dev/null
+        "$GAME" --headless --replay "$recording" --hash-log "$WORK_DIR/$name.replayed" > /dev/null
+
+        # A replay that drifts from the recording (or ends early) changes the log
+        if cmp -s "$WORK_DIR/$name.recorded" "$WORK_DIR/$name.replayed"; then
+            echo "✅ $action after $menuFrames menu frames: $(wc -l < "$WORK_DIR/$name.replayed") ticks replayed with matching state hashes"
+        else
+            echo "❌ $action after $menuFrames menu frames: replay diverged from the recording"
+            failed=1
+        fi
+    done
+done
+
+exit $failed
@@ -1,5 +1,6 @@
 #pragma once
 #include <SDL2/SDL.h>
+#include <cstdint>
 #include <string>
 
 // Pure ECS Components (Data Only)
@@ -8,9 +9,10 @@ struct Transform
 {
     float x, y;
     float rotation;
+    float previousX, previousY; // Position at the start of the current simulation tick, for render interpolation and bullet sweeps
 
     Transform(float x = 0, float y = 0, float rotation = 0)
-        : x(x), y(y), rotation(rotation) {}
+        : x(x), y(y), rotation(rotation), previousX(x), previousY(y) {}
 };
 
 struct Velocity
@@ -33,13 +35,53 @@ struct Sprite
         : texture(tex), width(w), height(h), frameCount(frames), frameTime(fTime), animated(frames > 1), currentTexturePath("") {}
 };
 
+// Collision layer bits. A collider sits on a layer and only collides with
+// colliders whose layer is in its mask, so pair types are decided by two
+// ANDs instead of looking up tags or owners.
+namespace CollisionLayer
+{
+    enum : std::uint32_t
+    {
+        NONE = 0,
+        PLAYER = 1u << 0,
+        MOB = 1u << 1,
+        MOB_KING = 1u << 2,
+        PLAYER_BULLET = 1u << 3,
+        MOB_BULLET = 1u << 4,
+
+        // Layers kept in the broadphase; bullets query it instead
+        BODIES = PLAYER | MOB | MOB_KING
+    };
+
+    // What a collider on `layer` collides with
+    inline std::uint32_t maskFor(std::uint32_t layer)
+    {
+        switch (layer)
+        {
+        case PLAYER:
+            return MOB | MOB_KING | MOB_BULLET;
+        case MOB:
+        case MOB_KING:
+            return PLAYER | PLAYER_BULLET;
+        case PLAYER_BULLET:
+            return MOB | MOB_KING;
+        case MOB_BULLET:
+            return PLAYER;
+        default:
+            return NONE;
+        }
+    }
+}
+
 struct Collider
 {
     float width, height;
     bool isTrigger;
+    std::uint32_t layer; // one CollisionLayer bit
+    std::uint32_t mask;  // CollisionLayer bits this collider hits
 
-    Collider(float w = 0, float h = 0, bool trigger = false)
-        : width(w), height(h), isTrigger(trigger) {}
+    Collider(float w = 0, float h = 0, bool trigger = false, std::uint32_t layer = CollisionLayer::NONE)
+        : width(w), height(h), isTrigger(trigger), layer(layer), mask(CollisionLayer::maskFor(layer)) {}
 };
 
 struct Speed
@@ -146,10 +188,11 @@ struct Weapon
     float range;     // Maximum shooting range
     float fireTimer; // Time since last shot
     bool canFire;
+    bool hitscan; // Shots hit the first body within range instantly instead of spawning a projectile
 
-    Weapon(float dmg = 25.0f, float rate = 5.0f, int ammo = 30, int maxAmmo = 30, float range = 300.0f)
+    Weapon(float dmg = 25.0f, float rate = 5.0f, int ammo = 30, int maxAmmo = 30, float range = 300.0f, bool hitscan = false)
         : damage(dmg), fireRate(rate), ammoCount(ammo), maxAmmo(maxAmmo),
-          range(range), fireTimer(0.0f), canFire(true) {}
+          range(range), fireTimer(0.0f), canFire(true), hitscan(hitscan) {}
 };
 
 struct Health
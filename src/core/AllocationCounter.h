@@ -0,0 +1,13 @@
+#pragma once
+#include <cstdint>
+
+// Heap allocations made through operator new since start-up, on any thread.
+// AllocationCounter.cpp replaces the global operator new/delete to count
+// them with two relaxed atomic adds per allocation.
+struct AllocationStats
+{
+    std::uint64_t count = 0;
+    std::uint64_t bytes = 0;
+};
+
+AllocationStats allocationStats();
@@ -0,0 +1,559 @@
+#pragma once
+#include "ECSTypes.h"
+#include <vector>
+#include <array>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+#include <algorithm>
+
+// Archetype storage backend (build with BLOODSTRIKE_ECS_ARCHETYPE). Entities
+// with exactly the same component set share an archetype; its rows live in
+// fixed-size chunks where every component type is its own contiguous column
+// (struct-of-arrays). Adding or removing a component moves the entity's row to
+// the neighbouring archetype, found through cached add/remove edges.
+struct Archetype {
+    static constexpr std::size_t CHUNK_BYTES = 16 * 1024;
+
+    ComponentSignature signature;
+    std::vector<ComponentTypeID> types;                // ascending ID, one per column
+    std::vector<const ComponentTypeInfo*> infos;       // parallel to types
+    std::vector<std::size_t> columnOffsets;            // byte offset of each column in a chunk
+    std::array<int, MAX_COMPONENTS> columnOf;          // component ID -> column, -1 if absent
+    std::array<Archetype*, MAX_COMPONENTS> addEdges{};
+    std::array<Archetype*, MAX_COMPONENTS> removeEdges{};
+    std::size_t chunkCapacity = 1;                     // rows per chunk
+    std::size_t chunkBytes = CHUNK_BYTES;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks;
+    std::size_t count = 0;                             // rows in use; all chunks but the last are full
+
+    Archetype(const ComponentSignature& signature, const std::vector<const ComponentTypeInfo*>& typeInfos)
+        : signature(signature) {
+        columnOf.fill(-1);
+        std::size_t rowBytes = sizeof(EntityID);
+        for (ComponentTypeID id = 0; id < PENDING_REMOVAL_BIT; ++id) {
+            if (signature.test(id)) {
+                assert(typeInfos[id] && "component type not registered");
+                assert(typeInfos[id]->align <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+                columnOf[id] = static_cast<int>(types.size());
+                types.push_back(id);
+                infos.push_back(typeInfos[id]);
+                rowBytes += typeInfos[id]->size;
+            }
+        }
+
+        columnOffsets.resize(types.size());
+        chunkCapacity = CHUNK_BYTES / rowBytes > 0 ? CHUNK_BYTES / rowBytes : 1;
+        while (chunkCapacity > 1 && layout(chunkCapacity) > CHUNK_BYTES) {
+            --chunkCapacity;
+        }
+        chunkBytes = std::max(CHUNK_BYTES, layout(chunkCapacity));
+    }
+
+    // Lays out the entity column then each component column for the given
+    // row count; returns the bytes needed
+    std::size_t layout(std::size_t rows) {
+        std::size_t offset = rows * sizeof(EntityID);
+        for (std::size_t col = 0; col < infos.size(); ++col) {
+            std::size_t align = infos[col]->align;
+            offset = (offset + align - 1) / align * align;
+            columnOffsets[col] = offset;
+            offset += rows * infos[col]->size;
+        }
+        return offset;
+    }
+
+    EntityID* entities(std::size_t chunk) {
+        return reinterpret_cast<EntityID*>(chunks[chunk].get());
+    }
+
+    void* column(std::size_t chunk, int col) {
+        return chunks[chunk].get() + columnOffsets[col];
+    }
+
+    std::size_t rowsInChunk(std::size_t chunk) const {
+        std::size_t start = chunk * chunkCapacity;
+        if (start >= count) {
+            return 0;
+        }
+        return std::min(count - start, chunkCapacity);
+    }
+
+    EntityID& entityAt(std::size_t row) {
+        return entities(row / chunkCapacity)[row % chunkCapacity];
+    }
+
+    void* componentAt(int col, std::size_t row) {
+        return static_cast<unsigned char*>(column(row / chunkCapacity, col)) +
+               (row % chunkCapacity) * infos[col]->size;
+    }
+
+    // Appends a row with uninitialised component slots; the caller constructs them
+    std::size_t allocateRow(EntityID entity) {
+        if (count == chunks.size() * chunkCapacity) {
+            chunks.emplace_back(new unsigned char[chunkBytes]);
+        }
+        std::size_t row = count++;
+        entityAt(row) = entity;
+        return row;
+    }
+
+    // Destroys the row's components and fills the hole with the last row.
+    // Returns the entity that moved into `row`, or NULL_ENTITY.
+    EntityID removeRow(std::size_t row) {
+        std::size_t last = count - 1;
+        for (std::size_t col = 0; col < infos.size(); ++col) {
+            infos[col]->destroy(componentAt(static_cast<int>(col), row));
+        }
+
+        EntityID moved = NULL_ENTITY;
+        if (row != last) {
+            for (std::size_t col = 0; col < infos.size(); ++col) {
+                int c = static_cast<int>(col);
+                infos[col]->moveConstruct(componentAt(c, row), componentAt(c, last));
+                infos[col]->destroy(componentAt(c, last));
+            }
+            entityAt(row) = entityAt(last);
+            moved = entityAt(row);
+        }
+        --count;
+
+        // Keep one empty chunk around so churn at a chunk boundary doesn't reallocate
+        if (chunks.size() >= 2 && count <= (chunks.size() - 2) * chunkCapacity) {
+            chunks.pop_back();
+        }
+        return moved;
+    }
+
+    ~Archetype() {
+        for (std::size_t row = 0; row < count; ++row) {
+            for (std::size_t col = 0; col < infos.size(); ++col) {
+                infos[col]->destroy(componentAt(static_cast<int>(col), row));
+            }
+        }
+    }
+};
+
+class ComponentRangeBase {
+public:
+    virtual ~ComponentRangeBase() = default;
+};
+
+// Every T in the world, archetype by archetype. Iterates (EntityID, T&) pairs
+// like ComponentPoolTyped so `for (auto &[entity, component] : ...)` works
+// with either backend.
+template<typename T>
+class ComponentRange : public ComponentRangeBase {
+private:
+    const std::vector<Archetype*>* archetypes;
+    ComponentTypeID id;
+
+public:
+    class iterator {
+    private:
+        const std::vector<Archetype*>* archetypes;
+        ComponentTypeID id;
+        std::size_t archetype;
+        std::size_t row;
+        std::optional<std::pair<EntityID, T&>> current;
+
+        void skipEmpty() {
+            while (archetype < archetypes->size() && row >= (*archetypes)[archetype]->count) {
+                ++archetype;
+                row = 0;
+            }
+        }
+
+    public:
+        iterator(const std::vector<Archetype*>* archetypes, ComponentTypeID id, std::size_t archetype)
+            : archetypes(archetypes), id(id), archetype(archetype), row(0) { skipEmpty(); }
+
+        std::pair<EntityID, T&>& operator*() {
+            Archetype* a = (*archetypes)[archetype];
+            current.emplace(a->entityAt(row), *static_cast<T*>(a->componentAt(a->columnOf[id], row)));
+            return *current;
+        }
+
+        iterator& operator++() {
+            ++row;
+            skipEmpty();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return archetype == other.archetype && row == other.row; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+    };
+
+    ComponentRange(const std::vector<Archetype*>* archetypes, ComponentTypeID id) : archetypes(archetypes), id(id) {}
+
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (Archetype* a : *archetypes) {
+            total += a->count;
+        }
+        return total;
+    }
+
+    bool empty() const { return size() == 0; }
+
+    iterator begin() { return iterator(archetypes, id, 0); }
+    iterator end() { return iterator(archetypes, id, archetypes->size()); }
+};
+
+// Multi-component join over every archetype whose signature contains the
+// data components in Ts...; tags in Ts are matched per entity through its
+// signature. Same contract as SparseSetView. each() walks chunk columns directly.
+template<typename... Ts>
+class ArchetypeView {
+private:
+    static_assert((!isTagComponent<Ts> || ...), "tag-only views are TagViews");
+
+    using Columns = std::array<int, sizeof...(Ts)>;
+
+    std::vector<Archetype*> matching;
+    std::vector<Columns> columns; // parallel to matching; -1 for tags
+    const std::vector<ComponentSignature>* signatures;
+    ComponentSignature required;
+    ComponentSignature mask; // required components plus the pending-removal bit
+
+    bool accepts(EntityID entity) const {
+        return ((*signatures)[entityIndex(entity)] & mask) == required;
+    }
+
+    template<typename T>
+    static T& fetch(Archetype* a, int col, std::size_t row) {
+        if constexpr (isTagComponent<T>) {
+            return tagInstance<T>();
+        } else {
+            return *static_cast<T*>(a->componentAt(col, row));
+        }
+    }
+
+    template<typename T>
+    static T* columnBase(Archetype* a, std::size_t chunk, int col) {
+        if constexpr (isTagComponent<T>) {
+            return nullptr;
+        } else {
+            return static_cast<T*>(a->column(chunk, col));
+        }
+    }
+
+    template<typename T>
+    static T& element(T* base, std::size_t i) {
+        if constexpr (isTagComponent<T>) {
+            return tagInstance<T>();
+        } else {
+            return base[i];
+        }
+    }
+
+    template<std::size_t... Is>
+    std::tuple<EntityID, Ts&...> row(std::size_t archetype, std::size_t row, std::index_sequence<Is...>) const {
+        Archetype* a = matching[archetype];
+        return std::tuple<EntityID, Ts&...>(a->entityAt(row), fetch<Ts>(a, columns[archetype][Is], row)...);
+    }
+
+    template<typename Fn, std::size_t... Is>
+    void eachChunk(Fn& fn, std::size_t archetype, std::size_t chunk, std::index_sequence<Is...>) const {
+        Archetype* a = matching[archetype];
+        std::size_t rows = a->rowsInChunk(chunk);
+        EntityID* entities = a->entities(chunk);
+        std::tuple<Ts*...> bases(columnBase<Ts>(a, chunk, columns[archetype][Is])...);
+        for (std::size_t i = 0; i < rows; ++i) {
+            if (accepts(entities[i])) {
+                fn(entities[i], element<Ts>(std::get<Is>(bases), i)...);
+            }
+        }
+    }
+
+public:
+    class iterator {
+    private:
+        const ArchetypeView* view;
+        std::size_t archetype;
+        std::size_t row;
+
+        void skipMissing() {
+            while (archetype < view->matching.size()) {
+                Archetype* a = view->matching[archetype];
+                if (row >= a->count) {
+                    ++archetype;
+                    row = 0;
+                } else if (!view->accepts(a->entityAt(row))) {
+                    ++row;
+                } else {
+                    break;
+                }
+            }
+        }
+
+    public:
+        iterator(const ArchetypeView* view, std::size_t archetype) : view(view), archetype(archetype), row(0) { skipMissing(); }
+
+        std::tuple<EntityID, Ts&...> operator*() const {
+            return view->row(archetype, row, std::index_sequence_for<Ts...>{});
+        }
+
+        iterator& operator++() {
+            ++row;
+            skipMissing();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return archetype == other.archetype && row == other.row; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+    };
+
+    ArchetypeView(const std::vector<ComponentSignature>& signatures, const std::vector<Archetype*>& candidates)
+        : signatures(&signatures), required(componentSignature<Ts...>()),
+          mask(ComponentSignature(required).set(PENDING_REMOVAL_BIT)) {
+        ComponentSignature dataRequired = dataSignature<Ts...>();
+        for (Archetype* a : candidates) {
+            if ((a->signature & dataRequired) == dataRequired) {
+                matching.push_back(a);
+                columns.push_back(Columns{(isTagComponent<Ts> ? -1 : a->columnOf[componentTypeID<Ts>()])...});
+            }
+        }
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, matching.size()); }
+
+    // Calls fn(EntityID, Ts&...) for every matching entity, chunk by chunk
+    template<typename Fn>
+    void each(Fn&& fn) const {
+        for (std::size_t archetype = 0; archetype < matching.size(); ++archetype) {
+            for (std::size_t chunk = 0; chunk < matching[archetype]->chunks.size(); ++chunk) {
+                eachChunk(fn, archetype, chunk, std::index_sequence_for<Ts...>{});
+            }
+        }
+    }
+
+    // One block per chunk of every matching archetype, numbered in each()
+    // order, so jobs can walk disjoint chunks concurrently
+    std::size_t blockCount() const {
+        std::size_t blocks = 0;
+        for (Archetype* a : matching) {
+            blocks += a->chunks.size();
+        }
+        return blocks;
+    }
+
+    // each() restricted to blocks [first, last)
+    template<typename Fn>
+    void eachBlock(std::size_t first, std::size_t last, Fn&& fn) const {
+        std::size_t block = 0;
+        for (std::size_t archetype = 0; archetype < matching.size() && block < last; ++archetype) {
+            std::size_t chunks = matching[archetype]->chunks.size();
+            for (std::size_t chunk = 0; chunk < chunks && block < last; ++chunk, ++block) {
+                if (block >= first) {
+                    eachChunk(fn, archetype, chunk, std::index_sequence_for<Ts...>{});
+                }
+            }
+        }
+    }
+};
+
+class ArchetypeStorage {
+private:
+    struct EntityLocation {
+        Archetype* archetype = nullptr;
+        std::size_t row = 0;
+    };
+
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::unordered_map<ComponentSignature, Archetype*> archetypeIndex;
+    std::vector<EntityLocation> locations; // entity index -> row
+    std::array<const ComponentTypeInfo*, MAX_COMPONENTS> typeInfos{};
+    std::array<std::vector<Archetype*>, MAX_COMPONENTS> archetypesWith; // component ID -> archetypes containing it
+    std::array<std::unique_ptr<ComponentRangeBase>, MAX_COMPONENTS> ranges;
+
+    template<typename T>
+    ComponentTypeID registerType() {
+        ComponentTypeID id = componentTypeID<T>();
+        if (!typeInfos[id]) {
+            typeInfos[id] = &componentTypeInfo<T>();
+        }
+        return id;
+    }
+
+    EntityLocation& location(EntityID entity) {
+        std::size_t index = entityIndex(entity);
+        if (index >= locations.size()) {
+            locations.resize(index + 1);
+        }
+        return locations[index];
+    }
+
+    // Row owned by exactly this handle, or nullptr (no components or stale)
+    EntityLocation* locate(EntityID entity) {
+        std::size_t index = entityIndex(entity);
+        if (index >= locations.size()) {
+            return nullptr;
+        }
+        EntityLocation& loc = locations[index];
+        if (!loc.archetype || loc.archetype->entityAt(loc.row) != entity) {
+            return nullptr;
+        }
+        return &loc;
+    }
+
+    Archetype* findOrCreate(const ComponentSignature& signature) {
+        if (signature.none()) {
+            return nullptr;
+        }
+        auto it = archetypeIndex.find(signature);
+        if (it != archetypeIndex.end()) {
+            return it->second;
+        }
+
+        std::vector<const ComponentTypeInfo*> infos(typeInfos.begin(), typeInfos.end());
+        archetypes.push_back(std::make_unique<Archetype>(signature, infos));
+        Archetype* created = archetypes.back().get();
+        archetypeIndex.emplace(signature, created);
+        for (ComponentTypeID id : created->types) {
+            archetypesWith[id].push_back(created);
+        }
+        return created;
+    }
+
+    Archetype* addTarget(Archetype* from, ComponentTypeID id) {
+        if (!from) {
+            return findOrCreate(ComponentSignature().set(id));
+        }
+        if (!from->addEdges[id]) {
+            Archetype* to = findOrCreate(ComponentSignature(from->signature).set(id));
+            from->addEdges[id] = to;
+            to->removeEdges[id] = from;
+        }
+        return from->addEdges[id];
+    }
+
+    Archetype* removeTarget(Archetype* from, ComponentTypeID id) {
+        if (!from->removeEdges[id]) {
+            Archetype* to = findOrCreate(ComponentSignature(from->signature).reset(id));
+            if (!to) {
+                return nullptr;
+            }
+            from->removeEdges[id] = to;
+            to->addEdges[id] = from;
+        }
+        return from->removeEdges[id];
+    }
+
+    void eraseRow(EntityLocation& loc) {
+        EntityID moved = loc.archetype->removeRow(loc.row);
+        if (moved != NULL_ENTITY) {
+            locations[entityIndex(moved)].row = loc.row;
+        }
+        loc = EntityLocation{};
+    }
+
+    // Moves the entity's shared components into a new row of `to`; components
+    // `to` lacks are destroyed, and columns `from` lacks are left for the caller
+    std::size_t migrate(EntityID entity, EntityLocation& loc, Archetype* to) {
+        std::size_t newRow = to->allocateRow(entity);
+        if (Archetype* from = loc.archetype) {
+            for (std::size_t col = 0; col < from->types.size(); ++col) {
+                int dst = to->columnOf[from->types[col]];
+                if (dst >= 0) {
+                    from->infos[col]->moveConstruct(to->componentAt(dst, newRow),
+                                                    from->componentAt(static_cast<int>(col), loc.row));
+                }
+            }
+            eraseRow(loc);
+        }
+        loc.archetype = to;
+        loc.row = newRow;
+        return newRow;
+    }
+
+public:
+    template<typename T>
+    ComponentRange<T>& components() {
+        ComponentTypeID id = registerType<T>();
+        if (!ranges[id]) {
+            ranges[id] = std::make_unique<ComponentRange<T>>(&archetypesWith[id], id);
+        }
+        return *static_cast<ComponentRange<T>*>(ranges[id].get());
+    }
+
+    template<typename T>
+    void add(EntityID entity, T component) {
+        ComponentTypeID id = registerType<T>();
+        EntityLocation& loc = location(entity);
+        if (loc.archetype && loc.archetype->columnOf[id] >= 0) {
+            *static_cast<T*>(loc.archetype->componentAt(loc.archetype->columnOf[id], loc.row)) = std::move(component);
+            return;
+        }
+
+        Archetype* to = addTarget(loc.archetype, id);
+        std::size_t row = migrate(entity, loc, to);
+        new (to->componentAt(to->columnOf[id], row)) T(std::move(component));
+    }
+
+    template<typename T>
+    T* get(EntityID entity) {
+        EntityLocation* loc = locate(entity);
+        if (!loc) {
+            return nullptr;
+        }
+        int col = loc->archetype->columnOf[componentTypeID<T>()];
+        return col >= 0 ? static_cast<T*>(loc->archetype->componentAt(col, loc->row)) : nullptr;
+    }
+
+    template<typename T>
+    void remove(EntityID entity) {
+        ComponentTypeID id = registerType<T>();
+        EntityLocation* loc = locate(entity);
+        if (!loc || loc->archetype->columnOf[id] < 0) {
+            return;
+        }
+
+        Archetype* to = removeTarget(loc->archetype, id);
+        if (to) {
+            migrate(entity, *loc, to);
+        } else {
+            eraseRow(*loc);
+        }
+    }
+
+    void removeEntity(EntityID entity, const ComponentSignature&) {
+        if (EntityLocation* loc = locate(entity)) {
+            eraseRow(*loc);
+        }
+    }
+
+    void removeEntities(const std::vector<EntityID>& entities, const std::vector<ComponentSignature>&) {
+        for (EntityID entity : entities) {
+            if (EntityLocation* loc = locate(entity)) {
+                eraseRow(*loc);
+            }
+        }
+    }
+
+    template<typename T>
+    std::vector<EntityID> entitiesWith() {
+        std::vector<EntityID> result;
+        for (Archetype* a : archetypesWith[registerType<T>()]) {
+            for (std::size_t row = 0; row < a->count; ++row) {
+                result.push_back(a->entityAt(row));
+            }
+        }
+        return result;
+    }
+
+    template<typename... Ts>
+    ArchetypeView<Ts...> view(const std::vector<ComponentSignature>& signatures) {
+        // Start from the shortest candidate list among the data components
+        const std::vector<Archetype*>* candidates = nullptr;
+        auto consider = [&](ComponentTypeID id) {
+            if (!candidates || archetypesWith[id].size() < candidates->size()) {
+                candidates = &archetypesWith[id];
+            }
+        };
+        ((isTagComponent<Ts> ? void() : consider(registerType<Ts>())), ...);
+        return ArchetypeView<Ts...>(signatures, *candidates);
+    }
+};
@@ -1,93 +1,276 @@
 #pragma once
-#include <typeindex>
-#include <unordered_map>
+#include "ECSTypes.h"
+#include "TagStorage.h"
 #include <vector>
+#include <array>
 #include <memory>
-#include <cassert>
+#include <deque>
+#include <functional>
 
-using EntityID = std::size_t;
+// Component storage is chosen at build time; both backends expose the same
+// interface to ECS. Configure with -DBLOODSTRIKE_ECS_ARCHETYPE=ON to A/B the
+// chunked archetype layout against the default sparse sets.
+#ifdef BLOODSTRIKE_ECS_ARCHETYPE
+#include "ArchetypeStorage.h"
+using ComponentStorage = ArchetypeStorage;
+#else
+#include "SparseSetStorage.h"
+using ComponentStorage = SparseSetStorage;
+#endif
 
-class ComponentPool {
+class ECS;
+
+// Records structural changes made while systems iterate and applies them in
+// bulk at the frame's sync point (Game::gameLoop calls flush()). Entities
+// queued for removal are hidden from views immediately but keep their
+// components until the flush; removals are then applied as one batch.
+class CommandBuffer {
 public:
-    virtual ~ComponentPool() = default;
-    virtual void remove(EntityID entity) = 0;
-};
+    explicit CommandBuffer(ECS& ecs) : ecs(&ecs) {}
 
-template<typename T>
-class ComponentPoolTyped : public ComponentPool {
-private:
-    std::unordered_map<EntityID, T> components;
+    // The handle is valid at once; queued components attach at flush
+    EntityID createEntity();
 
-public:
-    void add(EntityID entity, T component) {
-        components[entity] = std::move(component);
-    }
+    template<typename T>
+    void addComponent(EntityID entity, T component);
 
-    T* get(EntityID entity) {
-        auto it = components.find(entity);
-        return it != components.end() ? &it->second : nullptr;
-    }
+    void removeEntity(EntityID entity);
 
-    void remove(EntityID entity) override {
-        components.erase(entity);
-    }
+    void flush();
+    bool empty() const { return pendingAdds.empty() && pendingRemovals.empty(); }
 
-    std::unordered_map<EntityID, T>& getAll() {
-        return components;
-    }
+private:
+    ECS* ecs;
+    std::vector<std::function<void(ECS&)>> pendingAdds;
+    std::vector<EntityID> pendingRemovals;
 };
 
 class ECS {
 private:
-    EntityID nextEntityID = 1;
-    std::unordered_map<std::type_index, std::unique_ptr<ComponentPool>> componentPools;
+    friend class CommandBuffer;
+
+    // Freed slots are only reused once this many are queued, so a single slot
+    // is not recycled every frame and generations wrap far more slowly.
+    static constexpr std::size_t MIN_FREE_INDICES = 1024;
+
+    std::vector<std::uint32_t> generations{0}; // per slot index; slot 0 reserved
+    std::deque<std::uint32_t> freeIndices;      // FIFO of removed slot indices
+    std::vector<ComponentSignature> signatures{ComponentSignature{}}; // per slot index
+    ComponentStorage storage;                                         // data components
+    std::array<TagSet, MAX_COMPONENTS> tagSets;                       // tag components, by component ID
+    std::array<std::unique_ptr<TagRangeBase>, MAX_COMPONENTS> tagRanges;
+    ComponentSignature tagMask;                                       // IDs that are tags
+    CommandBuffer commandBuffer{*this};
+
+    void clearTags(std::uint32_t index) {
+        ComponentSignature tags = signatures[index] & tagMask;
+        for (ComponentTypeID id = 0; tags.any(); ++id) {
+            if (tags.test(id)) {
+                tagSets[id].reset(index);
+                tags.reset(id);
+            }
+        }
+    }
+
+    template<typename T>
+    TagRange<T>& tagRange() {
+        ComponentTypeID id = componentTypeID<T>();
+        if (!tagRanges[id]) {
+            tagRanges[id] = std::make_unique<TagRange<T>>(&tagSets[id], &generations);
+        }
+        return *static_cast<TagRange<T>*>(tagRanges[id].get());
+    }
 
 public:
     EntityID createEntity() {
-        return nextEntityID++;
+        std::uint32_t index;
+        if (freeIndices.size() > MIN_FREE_INDICES) {
+            index = freeIndices.front();
+            freeIndices.pop_front();
+        } else {
+            index = static_cast<std::uint32_t>(generations.size());
+            assert(index <= ENTITY_INDEX_MASK && "entity index space exhausted");
+            generations.push_back(0);
+            signatures.emplace_back();
+        }
+        return makeEntityID(index, generations[index]);
+    }
+
+    bool isAlive(EntityID entity) const {
+        std::uint32_t index = entityIndex(entity);
+        return entity != NULL_ENTITY && index < generations.size() &&
+               generations[index] == entityGeneration(entity);
     }
 
+    // Number of slot indices ever handed out; per-index side arrays can be
+    // sized to this and indexed with entityIndex()
+    std::size_t capacity() const { return generations.size(); }
+
     template<typename T>
     void addComponent(EntityID entity, T component) {
-        auto typeIndex = std::type_index(typeid(T));
-        
-        if (componentPools.find(typeIndex) == componentPools.end()) {
-            componentPools[typeIndex] = std::make_unique<ComponentPoolTyped<T>>();
+        assert(isAlive(entity) && "addComponent on a removed entity");
+        ComponentTypeID id = componentTypeID<T>();
+        if constexpr (isTagComponent<T>) {
+            tagSets[id].set(entityIndex(entity));
+            tagMask.set(id);
+        } else {
+            storage.add(entity, std::move(component));
         }
-        
-        auto pool = static_cast<ComponentPoolTyped<T>*>(componentPools[typeIndex].get());
-        pool->add(entity, std::move(component));
+        signatures[entityIndex(entity)].set(id);
     }
 
+    template<typename T>
+    void removeComponent(EntityID entity) {
+        if (!hasComponents<T>(entity)) {
+            return;
+        }
+        if constexpr (isTagComponent<T>) {
+            tagSets[componentTypeID<T>()].reset(entityIndex(entity));
+        } else {
+            storage.template remove<T>(entity);
+        }
+        signatures[entityIndex(entity)].reset(componentTypeID<T>());
+    }
+
+    // Returns nullptr for missing components and for stale handles
     template<typename T>
     T* getComponent(EntityID entity) {
-        auto typeIndex = std::type_index(typeid(T));
-        auto it = componentPools.find(typeIndex);
-        
-        if (it == componentPools.end()) {
-            return nullptr;
+        if constexpr (isTagComponent<T>) {
+            return hasComponents<T>(entity) ? &tagInstance<T>() : nullptr;
+        } else {
+            return storage.template get<T>(entity);
         }
-        
-        auto pool = static_cast<ComponentPoolTyped<T>*>(it->second.get());
-        return pool->get(entity);
     }
 
+    // Every T with its owner: a TagRange<T> for tags, otherwise the backend's
+    // ComponentPoolTyped<T> or ComponentRange<T>; bind with `auto &` and iterate
     template<typename T>
-    std::unordered_map<EntityID, T>& getComponents() {
-        auto typeIndex = std::type_index(typeid(T));
-        auto it = componentPools.find(typeIndex);
-        
-        if (it == componentPools.end()) {
-            componentPools[typeIndex] = std::make_unique<ComponentPoolTyped<T>>();
+    auto& getComponents() {
+        if constexpr (isTagComponent<T>) {
+            return tagRange<T>();
+        } else {
+            return storage.template components<T>();
+        }
+    }
+
+    // Creates storage for each type up front. Storage is otherwise created on
+    // first use, which must not happen while scheduled systems run in parallel.
+    template<typename... Ts>
+    void registerComponents() {
+        (getComponents<Ts>(), ...);
+    }
+
+    template<typename... Ts>
+    auto view() {
+        static_assert(sizeof...(Ts) > 0, "view requires at least one component type");
+        if constexpr ((isTagComponent<Ts> && ...)) {
+            return TagView<Ts...>({&tagSets[componentTypeID<Ts>()]...}, generations, signatures);
+        } else {
+            return storage.template view<Ts...>(signatures);
         }
-        
-        auto pool = static_cast<ComponentPoolTyped<T>*>(componentPools[typeIndex].get());
-        return pool->getAll();
     }
 
+    // Deferred structural changes, applied at the end-of-frame sync point
+    CommandBuffer& commands() { return commandBuffer; }
+
+    bool isPendingRemoval(EntityID entity) const {
+        return isAlive(entity) && signatures[entityIndex(entity)].test(PENDING_REMOVAL_BIT);
+    }
+
+    // Component bitmask of a live entity; empty for stale handles
+    ComponentSignature getSignature(EntityID entity) const {
+        return isAlive(entity) ? signatures[entityIndex(entity)] : ComponentSignature{};
+    }
+
+    template<typename... Ts>
+    bool hasComponents(EntityID entity) const {
+        ComponentSignature required = componentSignature<Ts...>();
+        return (getSignature(entity) & required) == required;
+    }
+
+    // Removing a stale or already-removed handle is a no-op
     void removeEntity(EntityID entity) {
-        for (auto& [typeIndex, pool] : componentPools) {
-            pool->remove(entity);
+        if (!isAlive(entity)) {
+            return;
+        }
+
+        // Only touches storage the entity actually has components in
+        std::uint32_t index = entityIndex(entity);
+        storage.removeEntity(entity, signatures[index]);
+        clearTags(index);
+        signatures[index].reset();
+
+        generations[index] = (generations[index] + 1) & ENTITY_GENERATION_MASK;
+        freeIndices.push_back(index);
+    }
+
+    // Batched removal, grouped per pool. Stale handles and duplicates are ignored.
+    void removeEntities(const std::vector<EntityID>& entities) {
+        // Retire the handles first; storage matches on the stored handle, not
+        // the generation, so their entries can still be found below
+        std::vector<EntityID> alive;
+        alive.reserve(entities.size());
+        for (EntityID entity : entities) {
+            if (isAlive(entity)) {
+                std::uint32_t index = entityIndex(entity);
+                generations[index] = (generations[index] + 1) & ENTITY_GENERATION_MASK;
+                alive.push_back(entity);
+            }
+        }
+
+        storage.removeEntities(alive, signatures);
+
+        for (EntityID entity : alive) {
+            clearTags(entityIndex(entity));
+            signatures[entityIndex(entity)].reset();
+            freeIndices.push_back(entityIndex(entity));
+        }
+    }
+
+    // Removes every entity that has a T component
+    template<typename T>
+    void removeEntitiesWith() {
+        if constexpr (isTagComponent<T>) {
+            std::vector<EntityID> tagged;
+            tagged.reserve(tagSets[componentTypeID<T>()].size());
+            for (auto& [entity, tag] : tagRange<T>()) {
+                tagged.push_back(entity);
+            }
+            removeEntities(tagged);
+        } else {
+            removeEntities(storage.template entitiesWith<T>());
         }
     }
 };
+
+inline EntityID CommandBuffer::createEntity() {
+    return ecs->createEntity();
+}
+
+template<typename T>
+void CommandBuffer::addComponent(EntityID entity, T component) {
+    pendingAdds.emplace_back([entity, component = std::move(component)](ECS& target) mutable {
+        if (target.isAlive(entity)) {
+            target.addComponent(entity, std::move(component));
+        }
+    });
+}
+
+inline void CommandBuffer::removeEntity(EntityID entity) {
+    if (!ecs->isAlive(entity) || ecs->isPendingRemoval(entity)) {
+        return;
+    }
+    ecs->signatures[entityIndex(entity)].set(PENDING_REMOVAL_BIT);
+    pendingRemovals.push_back(entity);
+}
+
+// Adds are applied in recording order, then all removals as one batch
+inline void CommandBuffer::flush() {
+    for (auto& add : pendingAdds) {
+        add(*ecs);
+    }
+    pendingAdds.clear();
+
+    ecs->removeEntities(pendingRemovals);
+    pendingRemovals.clear();
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <bitset>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+
+// Handle and component-ID definitions shared by the ECS and its storage backends
+
+// Entity handles pack a slot index (low bits) and a generation (high bits).
+// Slots are recycled after an entity is removed; bumping the generation makes
+// any handle still pointing at the old occupant stale. Index 0 is never
+// allocated, so a handle of 0 always means "no entity".
+using EntityID = std::uint32_t;
+
+constexpr std::uint32_t ENTITY_INDEX_BITS = 20;
+constexpr std::uint32_t ENTITY_GENERATION_BITS = 32 - ENTITY_INDEX_BITS;
+constexpr std::uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr std::uint32_t ENTITY_GENERATION_MASK = (1u << ENTITY_GENERATION_BITS) - 1;
+constexpr EntityID NULL_ENTITY = 0;
+
+constexpr std::uint32_t entityIndex(EntityID entity) { return entity & ENTITY_INDEX_MASK; }
+constexpr std::uint32_t entityGeneration(EntityID entity) { return entity >> ENTITY_INDEX_BITS; }
+constexpr EntityID makeEntityID(std::uint32_t index, std::uint32_t generation) {
+    return (generation << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+}
+
+// Sequential per-type component IDs, assigned on first use. They index the
+// per-entity signature bitmask and the ECS's flat pool table, so finding a
+// pool is a single array index rather than a type_index hash lookup.
+using ComponentTypeID = std::size_t;
+constexpr std::size_t MAX_COMPONENTS = 64;
+using ComponentSignature = std::bitset<MAX_COMPONENTS>;
+
+// The top signature bit is not a component: it flags entities queued for
+// removal in a CommandBuffer, which views skip until the buffer is flushed.
+constexpr std::size_t PENDING_REMOVAL_BIT = MAX_COMPONENTS - 1;
+
+inline ComponentTypeID nextComponentTypeID() {
+    static ComponentTypeID counter = 0;
+    ComponentTypeID id = counter++;
+    assert(id < PENDING_REMOVAL_BIT && "raise MAX_COMPONENTS");
+    return id;
+}
+
+template<typename T>
+ComponentTypeID componentTypeID() {
+    static const ComponentTypeID id = nextComponentTypeID();
+    return id;
+}
+
+template<typename... Ts>
+ComponentSignature componentSignature() {
+    ComponentSignature signature;
+    (signature.set(componentTypeID<Ts>()), ...);
+    return signature;
+}
+
+// Type-erased operations for storage that keeps components as raw columns
+struct ComponentTypeInfo {
+    std::size_t size;
+    std::size_t align;
+    void (*moveConstruct)(void* dst, void* src);
+    void (*destroy)(void* ptr);
+};
+
+template<typename T>
+const ComponentTypeInfo& componentTypeInfo() {
+    static const ComponentTypeInfo info{
+        sizeof(T),
+        alignof(T),
+        [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); },
+        [](void* ptr) { static_cast<T*>(ptr)->~T(); }
+    };
+    return info;
+}
+
+// Empty component types are tags: they live in per-type bitsets rather than
+// in the storage backend (see TagStorage.h)
+template<typename T>
+constexpr bool isTagComponent = std::is_empty_v<T>;
+
+// Shared instance handed out wherever a tag is returned by reference
+template<typename T>
+T& tagInstance() {
+    static T instance;
+    return instance;
+}
+
+// Signature of the non-tag components in Ts...
+template<typename... Ts>
+ComponentSignature dataSignature() {
+    ComponentSignature signature;
+    ((isTagComponent<Ts> ? void() : void(signature.set(componentTypeID<Ts>()))), ...);
+    return signature;
+}
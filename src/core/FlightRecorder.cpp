@@ -0,0 +1,128 @@
+#include "FlightRecorder.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+void FlightRecorder::configure(std::size_t frameCount, std::size_t framesAfterSpike, float budget, const std::string &prefix)
+{
+    ring.assign(frameCount, Frame());
+    next = 0;
+    stored = 0;
+    framesAfter = framesAfterSpike < frameCount ? framesAfterSpike : (frameCount > 0 ? frameCount - 1 : 0);
+    budgetMilliseconds = budget;
+    pathPrefix = prefix;
+    spikeFrame = -1;
+    framesUntilWrite = 0;
+}
+
+void FlightRecorder::setPoolNames(const std::vector<const char *> &names)
+{
+    poolNames.assign(names.begin(), names.begin() + (names.size() < MAX_POOLS ? names.size() : MAX_POOLS));
+}
+
+int FlightRecorder::systemColumn(const char *name)
+{
+    // Names are almost always the same literal, so try pointers first
+    for (std::size_t column = 0; column < systemNames.size(); column++)
+    {
+        if (systemNames[column] == name)
+        {
+            return static_cast<int>(column);
+        }
+    }
+    for (std::size_t column = 0; column < systemNames.size(); column++)
+    {
+        if (std::strcmp(systemNames[column], name) == 0)
+        {
+            return static_cast<int>(column);
+        }
+    }
+
+    if (systemNames.size() == MAX_SYSTEMS)
+    {
+        return -1;
+    }
+    systemNames.push_back(name);
+    return static_cast<int>(systemNames.size() - 1);
+}
+
+FlightRecorder::Frame &FlightRecorder::beginFrame(long frame)
+{
+    Frame &record = ring[next];
+    std::memset(&record, 0, sizeof(record));
+    record.frame = frame;
+    return record;
+}
+
+void FlightRecorder::commit()
+{
+    const Frame &record = ring[next];
+    next = (next + 1) % ring.size();
+    stored = stored < ring.size() ? stored + 1 : stored;
+
+    if (spikeFrame >= 0)
+    {
+        if (--framesUntilWrite == 0)
+        {
+            writeWindow();
+        }
+    }
+    else if (budgetMilliseconds > 0.0f && record.frameMilliseconds > budgetMilliseconds && record.frame > lastWrittenFrame)
+    {
+        spikeFrame = record.frame;
+        framesUntilWrite = framesAfter;
+        if (framesUntilWrite == 0)
+        {
+            writeWindow();
+        }
+    }
+}
+
+void FlightRecorder::writeWindow()
+{
+    std::string path = pathPrefix + std::to_string(spikeFrame) + ".csv";
+    std::ofstream file(path);
+    if (!file.is_open())
+    {
+        std::cerr << "Could not write flight recording: " << path << std::endl;
+    }
+    else
+    {
+        file << "frame,frame_ms,over_budget,ticks,simulation_ms,render_ms";
+        for (const char *name : systemNames)
+        {
+            file << ',' << name << "_ms";
+        }
+        for (const char *name : poolNames)
+        {
+            file << ',' << name;
+        }
+        file << ",messages_in,messages_out,texture_cache_misses,allocations,allocated_bytes\n";
+
+        // Oldest first
+        std::size_t first = (next + ring.size() - stored) % ring.size();
+        for (std::size_t i = 0; i < stored; i++)
+        {
+            const Frame &record = ring[(first + i) % ring.size()];
+            file << record.frame << ',' << record.frameMilliseconds << ','
+                 << (record.frameMilliseconds > budgetMilliseconds ? 1 : 0) << ',' << record.ticks << ','
+                 << record.simulationMilliseconds << ',' << record.renderMilliseconds;
+            for (std::size_t column = 0; column < systemNames.size(); column++)
+            {
+                file << ',' << record.systemMilliseconds[column];
+            }
+            for (std::size_t column = 0; column < poolNames.size(); column++)
+            {
+                file << ',' << record.poolSizes[column];
+            }
+            file << ',' << record.messagesIn << ',' << record.messagesOut << ',' << record.textureCacheMisses << ','
+                 << record.allocations << ',' << record.allocatedBytes << '\n';
+        }
+        std::cout << "Frame " << spikeFrame << " ran over its " << budgetMilliseconds << " ms budget; wrote the last "
+                  << stored << " frames to " << path << std::endl;
+    }
+
+    const Frame &newest = ring[(next + ring.size() - 1) % ring.size()];
+    lastWrittenFrame = newest.frame;
+    spikeFrame = -1;
+}
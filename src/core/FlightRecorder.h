@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Always-on record of the last few hundred frames. Each frame fills one
+// fixed-size record in a preallocated ring (no allocation, a few hundred
+// nanoseconds), and when a frame runs over budget the window around it,
+// including some frames after, is written out as CSV for later digging.
+class FlightRecorder
+{
+public:
+    static constexpr int MAX_SYSTEMS = 24;
+    static constexpr int MAX_POOLS = 16;
+
+    struct Frame
+    {
+        long frame;
+        float frameMilliseconds;      // This frame's start to the next one's
+        float simulationMilliseconds; // All of the frame's ticks
+        float renderMilliseconds;
+        std::uint32_t ticks;
+        float systemMilliseconds[MAX_SYSTEMS]; // Columns from systemColumn()
+        std::uint32_t poolSizes[MAX_POOLS];    // Columns from setPoolNames()
+        std::uint32_t messagesIn, messagesOut;
+        std::uint32_t textureCacheMisses;
+        std::uint32_t allocations;
+        std::uint64_t allocatedBytes;
+    };
+
+    // Keeps the last `frameCount` frames. A frame longer than
+    // budgetMilliseconds (0 disables dumps) writes the ring to
+    // <pathPrefix><frame>.csv once `framesAfter` more frames are in.
+    void configure(std::size_t frameCount, std::size_t framesAfter, float budgetMilliseconds, const std::string &pathPrefix);
+
+    // Names of the poolSizes columns; must outlive the recorder
+    void setPoolNames(const std::vector<const char *> &names);
+
+    // The systemMilliseconds column for a system, assigned on first use
+    // (-1 once all columns are taken)
+    int systemColumn(const char *name);
+
+    // The next record, zeroed; fill it in, then commit()
+    Frame &beginFrame(long frame);
+    void commit();
+
+    bool isEnabled() const { return !ring.empty(); }
+
+private:
+    void writeWindow();
+
+    std::vector<Frame> ring;
+    std::size_t next = 0;
+    std::size_t stored = 0;
+
+    std::size_t framesAfter = 0;
+    float budgetMilliseconds = 0.0f;
+    std::string pathPrefix;
+
+    long spikeFrame = -1;
+    std::size_t framesUntilWrite = 0;
+    long lastWrittenFrame = -1; // Spikes already inside a written window don't trigger another
+
+    std::vector<const char *> systemNames;
+    std::vector<const char *> poolNames;
+};
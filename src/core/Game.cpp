@@ -3,7 +3,41 @@
 #include "../managers/ResourceManager.h"
 #include "../managers/EntityFactory.h"
 #include "../managers/GameSettings.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "StateHash.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <thread>
+
+namespace
+{
+    // FNV-1a over the config files, so a replay can tell it is running
+    // against different settings than it was recorded with
+    std::uint64_t hashConfigFiles()
+    {
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+        for (const char *path : {"gameSettings.json", "entities.json"})
+        {
+            std::ifstream file(path, std::ios::binary);
+            for (std::istreambuf_iterator<char> c(file), end; c != end; ++c)
+            {
+                hash = (hash ^ static_cast<unsigned char>(*c)) * 0x100000001B3ull;
+            }
+        }
+        return hash;
+    }
+
+    // Component pools the flight recorder and metrics report, in countPools() order
+    const std::vector<const char *> POOL_NAMES = {"transforms", "velocities", "sprites", "colliders", "healths",
+                                                  "weapons", "projectiles", "mobs", "players", "ui_texts"};
+    const int PROJECTILE_POOL = 6;
+    const int MOB_POOL = 7;
+}
 
 Game::Game()
     : window(nullptr), renderer(nullptr), running(false), playerEntityID(0) {}
@@ -13,27 +47,16 @@ Game::~Game()
     // Destructor - cleanup is handled by shutdown()
 }
 
-bool Game::initialize()
+bool Game::initialize(const GameOptions &startOptions)
 {
-    // Initialize basic SDL first (without window)
-    if (SDL_Init(SDL_INIT_VIDEO) < 0)
-    {
-        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
-        return false;
-    }
+    options = startOptions;
+    startTime = std::chrono::steady_clock::now();
 
-    // Initialize SDL_image
-    int imgFlags = IMG_INIT_PNG;
-    if (!(IMG_Init(imgFlags) & imgFlags))
+    // Initialize basic SDL first (without window); a headless run only
+    // needs the event queue
+    if (SDL_Init(options.headless ? SDL_INIT_EVENTS : SDL_INIT_VIDEO) < 0)
     {
-        std::cerr << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl;
-        return false;
-    }
-
-    // Initialize SDL_ttf
-    if (TTF_Init() == -1)
-    {
-        std::cerr << "SDL_ttf could not initialize! SDL_ttf Error: " << TTF_GetError() << std::endl;
+        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
         return false;
     }
 
@@ -52,44 +75,26 @@ bool Game::initialize()
         std::cerr << "Warning: Failed to load game settings, using defaults" << std::endl;
     }
 
+    // A replay restores the recorded seed, tick rate and start action
+    if (!options.replayPath.empty() && !loadReplay())
+    {
+        return false;
+    }
+
     // Initialize GameManager with settings from GameSettings
     gameManager.screenWidth = gameSettings.getScreenWidth();
     gameManager.screenHeight = gameSettings.getScreenHeight();
     gameManager.mobSpawnInterval = gameSettings.getSinglePlayerMobSpawnInterval();
     gameManager.scorePerSecond = gameSettings.getSinglePlayerScorePerSecond();
 
-    // NOW create window with correct size
-    window = SDL_CreateWindow("Bloodstrike 2D",
-                              SDL_WINDOWPOS_UNDEFINED,
-                              SDL_WINDOWPOS_UNDEFINED,
-                              static_cast<int>(gameManager.screenWidth),
-                              static_cast<int>(gameManager.screenHeight),
-                              SDL_WINDOW_SHOWN);
-
-    if (!window)
-    {
-        std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
-        return false;
-    }
-
-    // Create renderer
-    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
-    if (!renderer)
+    // Headless runs keep the factory without a resource manager: sprites get
+    // their sizes from entities.json but no textures
+    if (options.headless)
     {
-        std::cerr << "Renderer could not be created! SDL Error: " << SDL_GetError() << std::endl;
-        return false;
+        std::cout << "Running headless" << std::endl;
     }
-
-    // Initialize resource manager
-    resourceManager = std::make_unique<ResourceManager>(renderer);
-
-    // Re-initialize entity factory with proper renderer
-    entityFactory = std::make_unique<EntityFactory>(resourceManager.get());
-
-    // Reload config with proper resource manager
-    if (!entityFactory->loadConfig("entities.json"))
+    else if (!initializeDisplay())
     {
-        std::cerr << "Failed to reload entity configuration" << std::endl;
         return false;
     }
 
@@ -99,18 +104,27 @@ bool Game::initialize()
     inputSystem = std::make_unique<InputSystem>();
     movementSystem = std::make_unique<MovementSystem>();
     animationSystem = std::make_unique<AnimationSystem>();
-    audioSystem = std::make_unique<AudioSystem>();
+    if (!options.headless)
+    {
+        audioSystem = std::make_unique<AudioSystem>();
+    }
     mobSpawningSystem = std::make_unique<MobSpawningSystem>(entityFactory.get(),
                                                             gameManager.screenWidth,
                                                             gameManager.screenHeight);
-    collisionSystem = std::make_unique<CollisionSystem>(audioSystem.get());
+    broadphaseSystem = std::make_unique<BroadphaseSystem>();
+    collisionSystem = std::make_unique<CollisionSystem>();
+    damageSystem = std::make_unique<DamageSystem>();
     boundarySystem = std::make_unique<BoundarySystem>(gameManager.screenWidth,
                                                       gameManager.screenHeight);
-    renderSystem = std::make_unique<RenderSystem>(renderer, resourceManager.get());
+    if (!options.headless)
+    {
+        renderSystem = std::make_unique<RenderSystem>(renderer, resourceManager.get());
+    }
 
     // Load menu configuration for MenuSystem
     json fullConfig = entityFactory->getEntityConfig();
     menuSystem->loadMenuConfig(fullConfig);
+    broadphaseSystem->loadColliderConfig(fullConfig);
 
     // Initialize Bloodstrike 2D combat systems
     aimingSystem = std::make_unique<AimingSystem>();
@@ -128,6 +142,15 @@ bool Game::initialize()
     mobSpawningSystem->setNetworkSystem(networkSystem.get());
     weaponSystem->setNetworkSystem(networkSystem.get());
     projectileSystem->setNetworkSystem(networkSystem.get());
+    damageSystem->setNetworkSystem(networkSystem.get());
+
+    // Collision queries and hitscan rays go through the per-frame broadphase;
+    // the damage system applies their hits
+    collisionSystem->setBroadphase(&broadphaseSystem->getBroadphase());
+    weaponSystem->setBroadphase(&broadphaseSystem->getBroadphase());
+    damageSystem->setCollisionSystem(collisionSystem.get());
+    damageSystem->setWeaponSystem(weaponSystem.get());
+    damageSystem->setAudioSystem(audioSystem.get());
 
     // Set game manager reference in NetworkSystem for game state synchronization
     networkSystem->setGameManager(&gameManager);
@@ -135,27 +158,291 @@ bool Game::initialize()
     networkSystem->setWeaponSystem(weaponSystem.get());
     networkSystem->setMovementSystem(movementSystem.get());
 
-    // Initialize audio system
-    if (!audioSystem->initialize())
+    // Input-driven systems read the tick's input frame, never SDL directly
+    inputSystem->setInput(&input);
+    aimingSystem->setInput(&input);
+    weaponSystem->setInput(&input);
+
+    seedRandomStreams();
+
+    // Scheduled systems may run on worker threads; create all component storage
+    // now so no system lazily creates it mid-frame
+    ecs.registerComponents<Transform, Velocity, Sprite, Collider, Speed, Animation, EntityType,
+                           UIText, UIPosition, MobKingHealthUI, PlayerTag, MobTag, MovementDirection,
+                           MouseTarget, AimingLine, Weapon, Health, Projectile, ProjectileTag,
+                           ProjectileColor, WeaponTag, NetworkPlayer, MobKing, MultiplayerGameState>();
+
+    float tickRate = options.tickRate > 0.0f ? options.tickRate : gameSettings.getSimulationTickRate();
+    options.tickRate = tickRate; // Recordings store the exact rate they ran at
+    timingSystem->setTickRate(tickRate, gameSettings.getMaxTicksPerFrame());
+    std::cout << "Simulation running at " << 1.0f / timingSystem->getFixedDeltaTime() << " ticks per second" << std::endl;
+
+    // A headless frame is one tick: paced to the tick rate in realtime mode,
+    // back to back otherwise
+    if (options.headless)
     {
-        std::cerr << "Failed to initialize audio system" << std::endl;
-        return false;
+        timingSystem->setFrameLimit(options.realtime ? static_cast<int>(tickRate + 0.5f) : 0, gameSettings.getFrameSpinMicroseconds());
+    }
+    else
+    {
+        bool uncapped = gameSettings.getFrameLimiter() == "uncapped";
+        timingSystem->setFrameLimit(uncapped ? 0 : gameSettings.getTargetFPS(), gameSettings.getFrameSpinMicroseconds());
     }
 
-    // Load audio assets
-    if (!loadAudioAssets())
+    int workerThreads = gameSettings.getWorkerThreads();
+    if (workerThreads <= 0)
     {
-        std::cerr << "Failed to load audio assets" << std::endl;
-        return false;
+        unsigned cores = std::thread::hardware_concurrency();
+        workerThreads = cores > 1 ? static_cast<int>(cores - 1) : 0;
+    }
+    jobSystem = std::make_unique<JobSystem>(static_cast<unsigned>(workerThreads));
+    scheduler = std::make_unique<SystemScheduler>(*jobSystem);
+    std::cout << "Job system using " << jobSystem->getWorkerCount() << " worker thread(s)" << std::endl;
+    configureFlightRecorder();
+    startMetricsServer();
+
+    movementSystem->setJobSystem(jobSystem.get());
+    weaponSystem->setJobSystem(jobSystem.get());
+    collisionSystem->setJobSystem(jobSystem.get());
+
+    if (audioSystem)
+    {
+        // Initialize audio system
+        if (!audioSystem->initialize())
+        {
+            std::cerr << "Failed to initialize audio system" << std::endl;
+            return false;
+        }
+
+        // Load audio assets
+        if (!loadAudioAssets())
+        {
+            std::cerr << "Failed to load audio assets" << std::endl;
+            return false;
+        }
     }
 
     // Create initial entities
     createInitialEntities();
 
+    // Nobody is at a headless menu, so start a game straight away
+    std::string startAction = options.startAction;
+    if (startAction.empty() && options.headless)
+    {
+        startAction = "singleplayer";
+    }
+    if (!startAction.empty() && options.startAfterFrames > 0 && options.replayPath.empty())
+    {
+        pendingStartAction = startAction;
+    }
+    else if (!startAction.empty())
+    {
+        menuSystem->executeMenuAction(startAction, gameManager);
+    }
+
+    if (!options.tracePath.empty())
+    {
+#ifdef BLOODSTRIKE_PROFILING
+        Profiler::getInstance().captureTrace(options.tracePath, options.traceFirstFrame, options.traceFrameCount);
+#else
+        std::cerr << "Built without BLOODSTRIKE_PROFILING; not writing " << options.tracePath << std::endl;
+#endif
+    }
+
     running = true;
     return true;
 }
 
+void Game::seedRandomStreams()
+{
+    GameSettings &gameSettings = GameSettings::getInstance();
+    deterministic = options.deterministic || gameSettings.isDeterministic();
+    if (options.deterministic)
+    {
+        masterSeed = options.seed;
+    }
+    else if (deterministic)
+    {
+        masterSeed = gameSettings.getSimulationSeed();
+    }
+    else
+    {
+        masterSeed = randomMasterSeed();
+    }
+
+    restartRandomStreams();
+
+    if (deterministic)
+    {
+        std::cout << "Deterministic simulation, seed " << masterSeed << std::endl;
+    }
+
+    if (!options.hashLogPath.empty())
+    {
+        hashLog.open(options.hashLogPath);
+        if (!hashLog.is_open())
+        {
+            std::cerr << "Could not open state hash log: " << options.hashLogPath << std::endl;
+        }
+    }
+}
+
+void Game::restartRandomStreams()
+{
+    // Each consumer derives its own stream, so they can't disturb each other
+    entityFactory->setRandomSeed(masterSeed);
+    mobSpawningSystem->setRandomSeed(masterSeed);
+    networkSystem->setRandomSeed(masterSeed);
+}
+
+void Game::recordStateHash()
+{
+    // Menu ticks differ between a recording and its replay, so hashes and
+    // tick numbers both start with the game
+    if (gameStartTick < 0)
+    {
+        return;
+    }
+
+    PROFILE_SCOPE("state hash");
+    stateHash = hashSimulationState(ecs);
+    if (hashLog.is_open())
+    {
+        hashLog << ticksRun - gameStartTick << ' ' << std::hex << std::setw(16) << std::setfill('0') << stateHash
+                << std::dec << std::setfill(' ') << '\n';
+    }
+}
+
+bool Game::loadReplay()
+{
+    if (!replay.open(options.replayPath))
+    {
+        return false;
+    }
+
+    const RecordingHeader &header = replay.getHeader();
+    if (header.configHash != hashConfigFiles())
+    {
+        std::cerr << "Warning: gameSettings.json or entities.json changed since the recording was made; the replay may diverge" << std::endl;
+    }
+
+    options.deterministic = true;
+    options.seed = header.seed;
+    options.tickRate = header.tickRate;
+    options.startAction = header.startAction;
+    options.recordPath.clear();
+    std::cout << "Replaying " << options.replayPath << ": " << header.startAction
+              << " at " << header.tickRate << " ticks per second, seed " << header.seed << std::endl;
+    return true;
+}
+
+bool Game::readInput()
+{
+    // The game starts with the first tick after the start action (the
+    // dual-player countdown included); a replay runs that action at start-up
+    // and skips the menus, so recording begins here to line up tick for tick
+    if (gameStartTick < 0 &&
+        (gameManager.currentState == GameManager::PLAYING || gameManager.currentState == GameManager::COUNTDOWN))
+    {
+        gameStartTick = ticksRun;
+    }
+
+    if (replay.isOpen())
+    {
+        return replay.next(input);
+    }
+
+    input = InputFrame::capture();
+
+    if (!options.recordPath.empty() && !recorder.isOpen() && gameStartTick >= 0)
+    {
+        startRecording();
+    }
+    recorder.record(input);
+    return true;
+}
+
+void Game::startRecording()
+{
+    // An online match also depends on what the other peer sends
+    if (gameManager.currentGameMode == GameManager::MULTIPLAYER_ONLINE)
+    {
+        std::cerr << "Input recording covers local games only; not recording this online match" << std::endl;
+        options.recordPath.clear();
+        return;
+    }
+
+    RecordingHeader header;
+    header.seed = masterSeed;
+    header.configHash = hashConfigFiles();
+    header.tickRate = options.tickRate;
+    header.startAction = gameManager.currentGameMode == GameManager::DUAL_PLAYER_LOCAL ? "dualplayer" : "singleplayer";
+    if (!recorder.open(options.recordPath, header))
+    {
+        options.recordPath.clear();
+        return;
+    }
+
+    // A replay starts its game with fresh streams; so does the recording
+    restartRandomStreams();
+    std::cout << "Recording input to " << options.recordPath << std::endl;
+}
+
+bool Game::initializeDisplay()
+{
+    // Initialize SDL_image
+    int imgFlags = IMG_INIT_PNG;
+    if (!(IMG_Init(imgFlags) & imgFlags))
+    {
+        std::cerr << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl;
+        return false;
+    }
+
+    // Initialize SDL_ttf
+    if (TTF_Init() == -1)
+    {
+        std::cerr << "SDL_ttf could not initialize! SDL_ttf Error: " << TTF_GetError() << std::endl;
+        return false;
+    }
+
+    // NOW create window with correct size
+    window = SDL_CreateWindow("Bloodstrike 2D",
+                              SDL_WINDOWPOS_UNDEFINED,
+                              SDL_WINDOWPOS_UNDEFINED,
+                              static_cast<int>(gameManager.screenWidth),
+                              static_cast<int>(gameManager.screenHeight),
+                              SDL_WINDOW_SHOWN);
+
+    if (!window)
+    {
+        std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    // Create renderer
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);
+    if (!renderer)
+    {
+        std::cerr << "Renderer could not be created! SDL Error: " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    // Initialize resource manager
+    resourceManager = std::make_unique<ResourceManager>(renderer);
+
+    // Re-initialize entity factory with proper renderer
+    entityFactory = std::make_unique<EntityFactory>(resourceManager.get());
+
+    // Reload config with proper resource manager
+    if (!entityFactory->loadConfig("entities.json"))
+    {
+        std::cerr << "Failed to reload entity configuration" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
 void Game::run()
 {
     while (running)
@@ -167,6 +454,32 @@ void Game::run()
 
 void Game::shutdown()
 {
+    if (metricsServer)
+    {
+        metricsServer->stop();
+        metricsServer.reset();
+    }
+
+#ifdef BLOODSTRIKE_PROFILING
+    Profiler::getInstance().finishTrace();
+#endif
+
+    if (timingSystem)
+    {
+        std::cout << "Ran " << ticksRun << " simulation ticks" << std::endl;
+        if (recorder.isOpen())
+        {
+            std::cout << "Recorded " << recorder.getTickCount() << " ticks of input to " << options.recordPath << std::endl;
+            recorder.close();
+        }
+        if (deterministic)
+        {
+            std::cout << "Final state hash " << std::hex << std::setw(16) << std::setfill('0') << stateHash
+                      << std::dec << std::setfill(' ') << " (seed " << masterSeed << ")" << std::endl;
+        }
+        timingSystem->dumpFrameTimes(std::cout);
+    }
+
     if (renderer)
     {
         SDL_DestroyRenderer(renderer);
@@ -179,8 +492,11 @@ void Game::shutdown()
         window = nullptr;
     }
 
-    TTF_Quit();
-    IMG_Quit();
+    if (!options.headless)
+    {
+        TTF_Quit();
+        IMG_Quit();
+    }
     SDL_Quit();
 }
 
@@ -255,26 +571,109 @@ void Game::createInitialEntities()
 
 void Game::gameLoop()
 {
+    PROFILE_FRAME();
+    auto frameStart = std::chrono::steady_clock::now();
+
     // 1. Update timing and calculate delta time
     float deltaTime = timingSystem->update();
 
     // 2. Handle menu system (always active)
+    if (!pendingStartAction.empty() && frameCount >= options.startAfterFrames)
+    {
+        menuSystem->executeMenuAction(pendingStartAction, gameManager);
+        pendingStartAction.clear();
+    }
     menuSystem->update(ecs, gameManager, deltaTime);
 
     // 2.5. Handle networking system (always active)
     networkSystem->update(ecs, gameManager, deltaTime);
 
-    // 3. Handle input
-    if (gameManager.isMultiplayer())
+    // 3. Advance the simulation in fixed ticks; a frame runs as many as its
+    // real time pays for, so results don't depend on the frame rate. A
+    // headless frame runs exactly one tick whatever its real time.
+    bool oneTickPerFrame = options.headless && !options.realtime;
+    timingSystem->accumulate(oneTickPerFrame ? timingSystem->getFixedDeltaTime() : deltaTime);
+    auto simulationStart = std::chrono::steady_clock::now();
+    std::uint32_t ticks = 0;
+    while (timingSystem->consumeTick())
     {
-        inputSystem->update(ecs, gameManager, networkSystem.get(), deltaTime);
+        if (!readInput())
+        {
+            std::cout << "Replay finished" << std::endl;
+            running = false;
+            break;
+        }
+        simulationTick(timingSystem->getFixedDeltaTime());
+        ticksRun++;
+        ticks++;
+        if (deterministic || hashLog.is_open())
+        {
+            recordStateHash();
+        }
+        if (options.maxTicks > 0 && ticksRun >= options.maxTicks)
+        {
+            running = false;
+            break;
+        }
     }
-    else
+
+    auto simulationEnd = std::chrono::steady_clock::now();
+
+    // 4. Update UI (update text content)
+    updateUI();
+
+    // 5. Render everything, blended between the last two ticks
+    auto renderStart = std::chrono::steady_clock::now();
+    if (renderSystem)
+    {
+        updateProfilerOverlay();
+        renderSystem->setInterpolationAlpha(timingSystem->getInterpolationAlpha());
+        renderSystem->update(ecs, gameManager, timingSystem->getFPS());
+    }
+    auto renderEnd = std::chrono::steady_clock::now();
+
+    // 6. Frame limiting to the configured target FPS
+    timingSystem->limitFrameRate();
+
+    if (flightRecorder.isEnabled())
+    {
+        using Milliseconds = std::chrono::duration<float, std::milli>;
+        recordFlightFrame(frameStart, Milliseconds(simulationEnd - simulationStart).count(),
+                          Milliseconds(renderEnd - renderStart).count(), ticks);
+    }
+    frameCount++;
+    if (metricsServer && std::chrono::steady_clock::now() - lastMetricsTime >=
+                             std::chrono::milliseconds(GameSettings::getInstance().getMetricsPublishIntervalMs()))
     {
-        inputSystem->update(ecs, gameManager, deltaTime);
+        publishMetrics();
+    }
+}
+
+void Game::simulationTick(float deltaTime)
+{
+    PROFILE_SCOPE("simulation tick");
+
+    // Rendering blends from where everything stood before this tick
+    ecs.view<Transform>().each([](EntityID, Transform &transform)
+    {
+        transform.previousX = transform.x;
+        transform.previousY = transform.y;
+    });
+
+    // Handle input
+    {
+        PROFILE_SCOPE("input");
+        if (gameManager.isMultiplayer())
+        {
+            inputSystem->update(ecs, gameManager, networkSystem.get(), deltaTime);
+        }
+        else
+        {
+            inputSystem->update(ecs, gameManager, deltaTime);
+        }
     }
 
-    // 3.5. Check if player state needs to be reset (after game restart)
+    // Check if player state needs to be reset (after game restart)
     if (gameManager.needsPlayerReset)
     {
         resetPlayerState();
@@ -284,13 +683,21 @@ void Game::gameLoop()
     // Always update game time for countdown and state management
     gameManager.updateGameTime(deltaTime);
 
-    // 4. Update game logic (only if playing)
+    // Update game logic (only if playing)
     if (gameManager.currentState == GameManager::PLAYING)
     {
+        // Systems are queued in their serial order; the scheduler only runs two
+        // at once when their declared component/resource access doesn't overlap
         // Movement and animation (always update for visual smoothness)
-        movementSystem->update(ecs, deltaTime);
-        animationSystem->update(ecs, deltaTime);
-        audioSystem->update(ecs, gameManager, deltaTime);
+        scheduler->add("movement", movementSystem->getAccess(), [&]
+                       { movementSystem->update(ecs, deltaTime); });
+        scheduler->add("animation", animationSystem->getAccess(), [&]
+                       { animationSystem->update(ecs, deltaTime); });
+        if (audioSystem)
+        {
+            scheduler->add("audio", audioSystem->getAccess(), [&]
+                           { audioSystem->update(ecs, gameManager, deltaTime); });
+        }
 
         // In multiplayer, only Host runs authoritative game logic
         // Client receives updates via network and only handles local rendering/input
@@ -302,47 +709,48 @@ void Game::gameLoop()
 
         if (shouldRunGameLogic)
         {
-            // Combat systems (Host only in multiplayer)
-            aimingSystem->update(ecs, gameManager, deltaTime);
-            weaponSystem->update(ecs, gameManager, deltaTime);
-            projectileSystem->update(ecs, gameManager, deltaTime);
-
-            // Mob and collision systems (Host only in multiplayer)
-            mobSpawningSystem->update(ecs, gameManager, deltaTime);
-            collisionSystem->update(ecs, gameManager, deltaTime);
-            boundarySystem->update(ecs, gameManager, deltaTime);
+            // Spatial index of players and mobs for the collision queries below
+            scheduler->add("broadphase", broadphaseSystem->getAccess(), [&]
+                           { broadphaseSystem->update(ecs, deltaTime); });
         }
-        else
-        {
-            // Client: Only run essential systems for local rendering
-            // Input is handled separately via InputSystem -> NetworkSystem
-            // Game state comes from Host via network messages
 
-            // Still run aiming for local player (input will be networked)
-            aimingSystem->update(ecs, gameManager, deltaTime);
+        // Combat systems (Host only in multiplayer). Clients still run aiming and
+        // weapons for local input (networked), projectiles for movement (lifetime
+        // is host-only inside update) and boundary for local cleanup.
+        scheduler->add("aiming", aimingSystem->getAccess(), [&]
+                       { aimingSystem->update(ecs, gameManager, deltaTime); });
+        scheduler->add("weapon", weaponSystem->getAccess(), [&]
+                       { weaponSystem->update(ecs, gameManager, deltaTime); });
+        scheduler->add("projectile", projectileSystem->getAccess(), [&]
+                       { projectileSystem->update(ecs, gameManager, deltaTime); });
+
+        if (shouldRunGameLogic)
+        {
+            // Mob and collision systems (Host only in multiplayer). Collision
+            // finds every contact of the frame; damage applies them.
+            scheduler->add("mobSpawning", mobSpawningSystem->getAccess(), [&]
+                           { mobSpawningSystem->update(ecs, gameManager, deltaTime); });
+            scheduler->add("collision", collisionSystem->getAccess(), [&]
+                           { collisionSystem->update(ecs, gameManager, deltaTime); });
+            scheduler->add("damage", damageSystem->getAccess(), [&]
+                           { damageSystem->update(ecs, gameManager, deltaTime); });
+        }
 
-            // Still run weapon system for local player input (will be networked)
-            weaponSystem->update(ecs, gameManager, deltaTime);
+        scheduler->add("boundary", boundarySystem->getAccess(), [&]
+                       { boundarySystem->update(ecs, gameManager, deltaTime); });
 
-            // Run projectile system for movement (collision detection is host-only inside update)
-            projectileSystem->update(ecs, gameManager, deltaTime);
+        scheduler->run();
 
-            // Still run boundary system for local entity cleanup
-            boundarySystem->update(ecs, gameManager, deltaTime);
+        // Sync point: apply entity removals/additions queued by the systems above
+        {
+            PROFILE_SCOPE("command flush");
+            ecs.commands().flush();
         }
 
         // UI systems (update after collision/damage systems)
+        PROFILE_SCOPE("health UI");
         healthUISystem->update(ecs, gameManager, deltaTime);
     }
-
-    // 5. Update UI (update text content)
-    updateUI();
-
-    // 6. Render everything
-    renderSystem->update(ecs, gameManager, timingSystem->getFPS());
-
-    // 7. Frame limiting to maintain 60 FPS
-    timingSystem->limitFrameRate();
 }
 
 void Game::handleEvents()
@@ -355,6 +763,25 @@ void Game::handleEvents()
             running = false;
         }
 
+        // F3 prints the recent frame-time histogram
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3)
+        {
+            timingSystem->dumpFrameTimes(std::cout);
+        }
+
+#ifdef BLOODSTRIKE_PROFILING
+        // F4 shows per-system times; F5 traces the next few seconds
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F4)
+        {
+            showProfilerOverlay = !showProfilerOverlay;
+        }
+        if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F5 && !Profiler::getInstance().isCapturing())
+        {
+            Profiler &profiler = Profiler::getInstance();
+            profiler.captureTrace("bloodstrike_trace.json", profiler.getFrameIndex() + 1, 300);
+        }
+#endif
+
         // Handle escape key for quitting
         if (e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_ESCAPE)
         {
@@ -374,8 +801,164 @@ void Game::handleEvents()
     }
 }
 
+void Game::updateProfilerOverlay()
+{
+#ifdef BLOODSTRIKE_PROFILING
+    std::vector<std::string> lines;
+    if (showProfilerOverlay)
+    {
+        char line[64];
+        for (const Profiler::ScopeTime &scope : Profiler::getInstance().getScopeTimes())
+        {
+            std::snprintf(line, sizeof(line), "%s: %.2f ms", scope.name, scope.milliseconds);
+            lines.push_back(line);
+        }
+    }
+    renderSystem->setDebugOverlay(std::move(lines));
+#endif
+}
+
+void Game::configureFlightRecorder()
+{
+    auto &gameSettings = GameSettings::getInstance();
+    int frames = gameSettings.getFlightRecorderFrames();
+    if (!gameSettings.isFlightRecorderEnabled() || frames <= 0)
+    {
+        return;
+    }
+
+    flightRecorder.configure(static_cast<std::size_t>(frames),
+                             static_cast<std::size_t>(std::max(0, gameSettings.getFlightRecorderFramesAfter())),
+                             gameSettings.getFlightRecorderBudgetMs(), gameSettings.getFlightRecorderPathPrefix());
+    flightRecorder.setPoolNames(POOL_NAMES);
+}
+
+void Game::countPools(std::uint32_t *sizes)
+{
+    sizes[0] = static_cast<std::uint32_t>(ecs.getComponents<Transform>().size());
+    sizes[1] = static_cast<std::uint32_t>(ecs.getComponents<Velocity>().size());
+    sizes[2] = static_cast<std::uint32_t>(ecs.getComponents<Sprite>().size());
+    sizes[3] = static_cast<std::uint32_t>(ecs.getComponents<Collider>().size());
+    sizes[4] = static_cast<std::uint32_t>(ecs.getComponents<Health>().size());
+    sizes[5] = static_cast<std::uint32_t>(ecs.getComponents<Weapon>().size());
+    sizes[6] = static_cast<std::uint32_t>(ecs.getComponents<Projectile>().size());
+    sizes[7] = static_cast<std::uint32_t>(ecs.getComponents<MobTag>().size());
+    sizes[8] = static_cast<std::uint32_t>(ecs.getComponents<PlayerTag>().size());
+    sizes[9] = static_cast<std::uint32_t>(ecs.getComponents<UIText>().size());
+}
+
+void Game::startMetricsServer()
+{
+    auto &gameSettings = GameSettings::getInstance();
+    int port = options.metricsPort > 0 ? options.metricsPort : (gameSettings.isMetricsEnabled() ? gameSettings.getMetricsPort() : 0);
+    if (port <= 0 || port > 65535)
+    {
+        return;
+    }
+
+    metricsServer = std::make_unique<MetricsServer>();
+    metricsServer->setPoolNames(POOL_NAMES);
+    if (!metricsServer->start(static_cast<std::uint16_t>(port)))
+    {
+        metricsServer.reset();
+        return;
+    }
+    lastMetricsTime = std::chrono::steady_clock::now();
+    publishMetrics();
+}
+
+void Game::publishMetrics()
+{
+    PROFILE_SCOPE("metrics");
+
+    auto now = std::chrono::steady_clock::now();
+    float seconds = std::chrono::duration<float>(now - lastMetricsTime).count();
+    lastMetricsTime = now;
+
+    MetricsSnapshot snapshot = {};
+    snapshot.uptimeSeconds = std::chrono::duration<double>(now - startTime).count();
+    snapshot.frames = frameCount;
+    snapshot.ticks = ticksRun;
+
+    FrameTimeStats frameTimes = timingSystem->getFrameTimeStats();
+    snapshot.frameTimeAverage = frameTimes.average;
+    snapshot.frameTimeP50 = frameTimes.p50;
+    snapshot.frameTimeP95 = frameTimes.p95;
+    snapshot.frameTimeP99 = frameTimes.p99;
+    snapshot.frameTimeMax = frameTimes.max;
+
+    countPools(snapshot.poolSizes);
+    snapshot.projectilesAlive = snapshot.poolSizes[PROJECTILE_POOL];
+    snapshot.mobsAlive = snapshot.poolSizes[MOB_POOL];
+
+    snapshot.networkConnected = networkSystem->isConnected();
+    snapshot.roundTripMilliseconds = networkSystem->getRoundTripMilliseconds();
+    snapshot.messagesReceived = networkSystem->getMessagesReceived();
+    snapshot.messagesSent = networkSystem->getMessagesSent();
+    snapshot.bytesReceived = networkSystem->getBytesReceived();
+    snapshot.bytesSent = networkSystem->getBytesSent();
+    if (seconds > 0.0f)
+    {
+        snapshot.messagesReceivedPerSecond = (snapshot.messagesReceived - lastMetrics.messagesReceived) / seconds;
+        snapshot.messagesSentPerSecond = (snapshot.messagesSent - lastMetrics.messagesSent) / seconds;
+        snapshot.bytesReceivedPerSecond = (snapshot.bytesReceived - lastMetrics.bytesReceived) / seconds;
+        snapshot.bytesSentPerSecond = (snapshot.bytesSent - lastMetrics.bytesSent) / seconds;
+    }
+    snapshot.incomingQueueDepth = static_cast<std::uint32_t>(networkSystem->getIncomingQueueDepth());
+    snapshot.outgoingQueueDepth = static_cast<std::uint32_t>(networkSystem->getOutgoingQueueDepth());
+
+    metricsServer->publish(snapshot);
+    lastMetrics = snapshot;
+}
+
+void Game::recordFlightFrame(std::chrono::steady_clock::time_point frameStart, float simulationMilliseconds,
+                             float renderMilliseconds, std::uint32_t ticks)
+{
+    FlightRecorder::Frame &frame = flightRecorder.beginFrame(frameCount);
+    frame.frameMilliseconds =
+        std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - frameStart).count();
+    frame.simulationMilliseconds = simulationMilliseconds;
+    frame.renderMilliseconds = renderMilliseconds;
+    frame.ticks = ticks;
+
+    for (const SystemScheduler::SystemTime &system : scheduler->getSystemTimes())
+    {
+        int column = flightRecorder.systemColumn(system.name);
+        if (column >= 0)
+        {
+            frame.systemMilliseconds[column] = system.milliseconds;
+        }
+    }
+    scheduler->resetSystemTimes();
+
+    countPools(frame.poolSizes);
+
+    std::uint32_t messagesIn = networkSystem->getMessagesReceived();
+    std::uint32_t messagesOut = networkSystem->getMessagesSent();
+    frame.messagesIn = messagesIn - lastMessagesIn;
+    frame.messagesOut = messagesOut - lastMessagesOut;
+    lastMessagesIn = messagesIn;
+    lastMessagesOut = messagesOut;
+
+    if (resourceManager)
+    {
+        unsigned textureCacheMisses = resourceManager->getTextureCacheMisses();
+        frame.textureCacheMisses = textureCacheMisses - lastTextureCacheMisses;
+        lastTextureCacheMisses = textureCacheMisses;
+    }
+
+    AllocationStats allocations = allocationStats();
+    frame.allocations = static_cast<std::uint32_t>(allocations.count - lastAllocations.count);
+    frame.allocatedBytes = allocations.bytes - lastAllocations.bytes;
+    lastAllocations = allocations;
+
+    flightRecorder.commit();
+}
+
 void Game::updateUI()
 {
+    PROFILE_SCOPE("ui");
+
     // Update score display
     auto &uiTextComponents = ecs.getComponents<UIText>();
     for (auto &[entityID, uiText] : uiTextComponents)
@@ -480,39 +1063,11 @@ void Game::resetPlayerState()
     mobSpawningSystem->reset();
 
     // Clear all existing mobs and projectiles
-    auto &mobTags = ecs.getComponents<MobTag>();
-    std::vector<EntityID> mobsToRemove;
-    for (auto &[mobEntityID, mobTag] : mobTags)
-    {
-        mobsToRemove.push_back(mobEntityID);
-    }
-    for (EntityID mobID : mobsToRemove)
-    {
-        ecs.removeEntity(mobID);
-    }
-
-    auto &projectileTags = ecs.getComponents<ProjectileTag>();
-    std::vector<EntityID> projectilesToRemove;
-    for (auto &[projectileEntityID, projectileTag] : projectileTags)
-    {
-        projectilesToRemove.push_back(projectileEntityID);
-    }
-    for (EntityID projectileID : projectilesToRemove)
-    {
-        ecs.removeEntity(projectileID);
-    }
+    ecs.removeEntitiesWith<MobTag>();
+    ecs.removeEntitiesWith<ProjectileTag>();
 
     // Clear Mob King health UI
-    auto &healthUIComponents = ecs.getComponents<MobKingHealthUI>();
-    std::vector<EntityID> healthUIToRemove;
-    for (auto &[uiEntityID, healthUI] : healthUIComponents)
-    {
-        healthUIToRemove.push_back(uiEntityID);
-    }
-    for (EntityID uiID : healthUIToRemove)
-    {
-        ecs.removeEntity(uiID);
-    }
+    ecs.removeEntitiesWith<MobKingHealthUI>();
 
     // Reset player's weapon ammo when game restarts
     auto &playerTags = ecs.getComponents<PlayerTag>();
@@ -537,6 +1092,10 @@ void Game::resetPlayerState()
                 transform->x = playerConfig["startPosition"]["x"].get<float>();
                 transform->y = playerConfig["startPosition"]["y"].get<float>();
             }
+
+            // A jump, not a move: don't interpolate across it
+            transform->previousX = transform->x;
+            transform->previousY = transform->y;
         }
 
         // Reset player velocity
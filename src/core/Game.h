@@ -1,15 +1,45 @@
 #pragma once
 #include "ECS.h"
+#include "AllocationCounter.h"
+#include "FlightRecorder.h"
+#include "JobSystem.h"
+#include "InputRecording.h"
+#include "MetricsServer.h"
+#include "SystemScheduler.h"
 #include "../managers/GameManager.h"
 #include "../systems/Systems.h"
 #include "../managers/EntityFactory.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
 #include <memory>
+#include <string>
 
 class ResourceManager; // Forward declaration
 
+// Start-up choices, normally from the command line
+struct GameOptions
+{
+    bool headless = false;   // No window, renderer, fonts, textures or audio output
+    bool realtime = false;   // Headless only: pace ticks to the wall clock instead of running flat out
+    float tickRate = 0.0f;   // Overrides simulation.tickRate when above 0
+    long maxTicks = 0;       // Quit after this many simulation ticks (0 runs until quit)
+    std::string startAction; // Menu action run at start-up ("singleplayer", "host", ...); headless defaults to "singleplayer"
+    long startAfterFrames = 0; // Wait at the menu this many frames before running startAction, as a player would
+    bool deterministic = false; // Seed every random stream from `seed`; simulation.deterministic also turns it on
+    std::uint64_t seed = 0;
+    std::string hashLogPath; // Writes each tick's state hash here when set
+    std::string recordPath;  // Records each tick's input here, from the first tick after the start action
+    std::string replayPath;  // Plays a recording back instead of reading the keyboard and mouse
+    std::string tracePath;   // Chrome trace of frames [traceFirstFrame, traceFirstFrame + traceFrameCount) (profiling builds)
+    long traceFirstFrame = 0;
+    long traceFrameCount = 300;
+    int metricsPort = 0; // Serves metrics on this port when above 0; metrics.enabled uses metrics.port
+};
+
 class Game
 {
 private:
@@ -22,6 +52,41 @@ private:
     SDL_Renderer *renderer;
     bool running;
 
+    GameOptions options;
+    long ticksRun = 0;
+    long gameStartTick = -1; // ticksRun when the first tick after the start action began; -1 at the menu
+    std::string pendingStartAction; // Run once startAfterFrames have passed
+
+    // Deterministic runs seed every random stream from one master seed and
+    // hash the simulation state after each tick
+    bool deterministic = false;
+    std::uint64_t masterSeed = 0;
+    std::uint64_t stateHash = 0;
+    std::ofstream hashLog;
+
+    // The input every system reads this tick: captured live, or replayed
+    InputFrame input;
+    InputRecorder recorder;
+    InputReplay replay;
+
+    // Per-system times in the corner, toggled with F4 (profiling builds)
+    bool showProfilerOverlay = false;
+
+    // The last few hundred frames, written out when one runs over budget;
+    // counters are kept as totals so each frame records the difference
+    FlightRecorder flightRecorder;
+    long frameCount = 0;
+    AllocationStats lastAllocations;
+    std::uint32_t lastMessagesIn = 0;
+    std::uint32_t lastMessagesOut = 0;
+    unsigned lastTextureCacheMisses = 0;
+
+    // Live telemetry for soak runs, published every few hundred milliseconds
+    std::unique_ptr<MetricsServer> metricsServer;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point lastMetricsTime;
+    MetricsSnapshot lastMetrics = {};
+
     // Resource management
     std::unique_ptr<ResourceManager> resourceManager;
     std::unique_ptr<EntityFactory> entityFactory;
@@ -34,7 +99,9 @@ private:
     std::unique_ptr<AnimationSystem> animationSystem;
     std::unique_ptr<AudioSystem> audioSystem;
     std::unique_ptr<MobSpawningSystem> mobSpawningSystem;
+    std::unique_ptr<BroadphaseSystem> broadphaseSystem;
     std::unique_ptr<CollisionSystem> collisionSystem;
+    std::unique_ptr<DamageSystem> damageSystem;
     std::unique_ptr<BoundarySystem> boundarySystem;
     std::unique_ptr<RenderSystem> renderSystem;
 
@@ -49,6 +116,12 @@ private:
     // Bloodstrike 2D UI Systems
     std::unique_ptr<HealthUISystem> healthUISystem;
 
+    // Worker pool shared by the scheduler and systems' parallel loops
+    std::unique_ptr<JobSystem> jobSystem;
+
+    // Runs the gameplay systems each frame, in parallel where their access allows
+    std::unique_ptr<SystemScheduler> scheduler;
+
     // TODO: Systems to be implemented in Phase 4
     // std::unique_ptr<HudSystem> hudSystem;
     // std::unique_ptr<CleanupSystem> cleanupSystem;    // Entity IDs
@@ -58,16 +131,31 @@ public:
     Game();
     ~Game();
 
-    bool initialize();
+    bool initialize(const GameOptions &startOptions = GameOptions());
     void run();
     void shutdown();
 
 private:
     bool loadAssets();
+    bool initializeDisplay();
     bool loadAudioAssets();
     void createInitialEntities();
     void gameLoop();
+    void simulationTick(float deltaTime);
+    void seedRandomStreams();
+    void restartRandomStreams();
+    void recordStateHash();
+    bool loadReplay();
+    bool readInput();
+    void startRecording();
     void handleEvents();
     void updateUI();
+    void updateProfilerOverlay();
+    void configureFlightRecorder();
+    void startMetricsServer();
+    void publishMetrics();
+    void countPools(std::uint32_t *sizes);
+    void recordFlightFrame(std::chrono::steady_clock::time_point frameStart, float simulationMilliseconds,
+                           float renderMilliseconds, std::uint32_t ticks);
     void resetPlayerState();
 };
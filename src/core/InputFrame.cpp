@@ -0,0 +1,46 @@
+#include "InputFrame.h"
+
+namespace
+{
+    // Bit i of InputFrame::keys is GAMEPLAY_KEYS[i]. Append new keys at the
+    // end so existing recordings keep their meaning.
+    const SDL_Scancode GAMEPLAY_KEYS[] = {
+        SDL_SCANCODE_W, SDL_SCANCODE_A, SDL_SCANCODE_S, SDL_SCANCODE_D,
+        SDL_SCANCODE_UP, SDL_SCANCODE_LEFT, SDL_SCANCODE_DOWN, SDL_SCANCODE_RIGHT,
+        SDL_SCANCODE_I, SDL_SCANCODE_J, SDL_SCANCODE_K, SDL_SCANCODE_L,
+        SDL_SCANCODE_P, SDL_SCANCODE_SPACE, SDL_SCANCODE_R};
+
+    constexpr int GAMEPLAY_KEY_COUNT = sizeof(GAMEPLAY_KEYS) / sizeof(GAMEPLAY_KEYS[0]);
+    static_assert(GAMEPLAY_KEY_COUNT <= 16, "InputFrame::keys holds 16 keys");
+}
+
+bool InputFrame::isKeyDown(SDL_Scancode key) const
+{
+    for (int i = 0; i < GAMEPLAY_KEY_COUNT; i++)
+    {
+        if (GAMEPLAY_KEYS[i] == key)
+        {
+            return (keys & (1u << i)) != 0;
+        }
+    }
+    return false;
+}
+
+InputFrame InputFrame::capture()
+{
+    InputFrame frame;
+    const Uint8 *keyboardState = SDL_GetKeyboardState(nullptr);
+    for (int i = 0; i < GAMEPLAY_KEY_COUNT; i++)
+    {
+        if (keyboardState[GAMEPLAY_KEYS[i]])
+        {
+            frame.keys |= static_cast<std::uint16_t>(1u << i);
+        }
+    }
+
+    int x, y;
+    frame.mouseButtons = static_cast<std::uint8_t>(SDL_GetMouseState(&x, &y));
+    frame.mouseX = static_cast<std::int16_t>(x);
+    frame.mouseY = static_cast<std::int16_t>(y);
+    return frame;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+
+// Everything the simulation reads from the keyboard and mouse in one tick.
+// Game captures it once per tick (or reads it back from a recording) and the
+// input-driven systems read this instead of SDL, so a tick's input is fixed
+// before any system runs and can be replayed exactly.
+struct InputFrame
+{
+    std::uint16_t keys = 0;         // One bit per gameplay key, see isKeyDown()
+    std::uint8_t mouseButtons = 0;  // SDL_BUTTON() mask
+    std::int16_t mouseX = 0, mouseY = 0;
+
+    // Only the keys gameplay uses are kept; any other key reads as up
+    bool isKeyDown(SDL_Scancode key) const;
+    bool isMouseButtonDown(int button) const { return (mouseButtons & SDL_BUTTON(button)) != 0; }
+
+    // The live keyboard and mouse state
+    static InputFrame capture();
+
+    bool operator==(const InputFrame &other) const
+    {
+        return keys == other.keys && mouseButtons == other.mouseButtons &&
+               mouseX == other.mouseX && mouseY == other.mouseY;
+    }
+    bool operator!=(const InputFrame &other) const { return !(*this == other); }
+};
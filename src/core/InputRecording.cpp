@@ -0,0 +1,163 @@
+#include "InputRecording.h"
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+    const char MAGIC[4] = {'B', 'S', 'I', 'R'};
+    constexpr std::uint32_t FORMAT_VERSION = 1;
+
+    void writeBytes(std::ostream &out, std::uint64_t value, int byteCount)
+    {
+        for (int byte = 0; byte < byteCount; byte++)
+        {
+            out.put(static_cast<char>((value >> (byte * 8)) & 0xFF));
+        }
+    }
+
+    bool readBytes(std::istream &in, std::uint64_t &value, int byteCount)
+    {
+        value = 0;
+        for (int byte = 0; byte < byteCount; byte++)
+        {
+            int c = in.get();
+            if (c == std::char_traits<char>::eof())
+            {
+                return false;
+            }
+            value |= static_cast<std::uint64_t>(c & 0xFF) << (byte * 8);
+        }
+        return true;
+    }
+}
+
+bool InputRecorder::open(const std::string &path, const RecordingHeader &header)
+{
+    close();
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+    {
+        std::cerr << "Could not open input recording: " << path << std::endl;
+        return false;
+    }
+
+    std::uint32_t tickRateBits;
+    std::memcpy(&tickRateBits, &header.tickRate, sizeof(tickRateBits));
+    std::size_t actionLength = header.startAction.size() < 255 ? header.startAction.size() : 255;
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeBytes(file, FORMAT_VERSION, 4);
+    writeBytes(file, header.seed, 8);
+    writeBytes(file, header.configHash, 8);
+    writeBytes(file, tickRateBits, 4);
+    writeBytes(file, actionLength, 1);
+    file.write(header.startAction.data(), static_cast<std::streamsize>(actionLength));
+
+    runLength = 0;
+    ticks = 0;
+    return true;
+}
+
+void InputRecorder::record(const InputFrame &frame)
+{
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    if (runLength > 0 && (frame != runFrame || runLength == UINT32_MAX))
+    {
+        writeRun();
+    }
+    if (runLength == 0)
+    {
+        runFrame = frame;
+    }
+    runLength++;
+    ticks++;
+}
+
+void InputRecorder::writeRun()
+{
+    writeBytes(file, runLength, 4);
+    writeBytes(file, runFrame.keys, 2);
+    writeBytes(file, runFrame.mouseButtons, 1);
+    writeBytes(file, static_cast<std::uint16_t>(runFrame.mouseX), 2);
+    writeBytes(file, static_cast<std::uint16_t>(runFrame.mouseY), 2);
+    runLength = 0;
+}
+
+void InputRecorder::close()
+{
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    if (runLength > 0)
+    {
+        writeRun();
+    }
+    file.close();
+}
+
+bool InputReplay::open(const std::string &path)
+{
+    file.open(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        std::cerr << "Could not open input recording: " << path << std::endl;
+        return false;
+    }
+
+    char magic[sizeof(MAGIC)];
+    std::uint64_t version, seed, configHash, tickRateBits, actionLength;
+    bool valid = file.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0 &&
+                 readBytes(file, version, 4) && version == FORMAT_VERSION &&
+                 readBytes(file, seed, 8) && readBytes(file, configHash, 8) &&
+                 readBytes(file, tickRateBits, 4) && readBytes(file, actionLength, 1);
+    if (valid)
+    {
+        header.startAction.resize(static_cast<std::size_t>(actionLength));
+        valid = actionLength == 0 || file.read(&header.startAction[0], static_cast<std::streamsize>(actionLength));
+    }
+    if (!valid)
+    {
+        std::cerr << "Not a Bloodstrike input recording (or an unsupported version): " << path << std::endl;
+        file.close();
+        return false;
+    }
+
+    std::uint32_t tickRate32 = static_cast<std::uint32_t>(tickRateBits);
+    header.seed = seed;
+    header.configHash = configHash;
+    std::memcpy(&header.tickRate, &tickRate32, sizeof(header.tickRate));
+    runRemaining = 0;
+    return true;
+}
+
+bool InputReplay::next(InputFrame &frame)
+{
+    if (runRemaining == 0)
+    {
+        std::uint64_t length, keys, buttons, x, y;
+        if (!file.is_open() || !readBytes(file, length, 4) || !readBytes(file, keys, 2) ||
+            !readBytes(file, buttons, 1) || !readBytes(file, x, 2) || !readBytes(file, y, 2))
+        {
+            return false;
+        }
+        runRemaining = static_cast<std::uint32_t>(length);
+        runFrame.keys = static_cast<std::uint16_t>(keys);
+        runFrame.mouseButtons = static_cast<std::uint8_t>(buttons);
+        runFrame.mouseX = static_cast<std::int16_t>(static_cast<std::uint16_t>(x));
+        runFrame.mouseY = static_cast<std::int16_t>(static_cast<std::uint16_t>(y));
+        if (runRemaining == 0)
+        {
+            return false;
+        }
+    }
+
+    runRemaining--;
+    frame = runFrame;
+    return true;
+}
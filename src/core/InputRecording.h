@@ -0,0 +1,58 @@
+#pragma once
+#include "InputFrame.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// What a replay needs besides the input itself to repeat a recorded game
+struct RecordingHeader
+{
+    std::uint64_t seed = 0;       // Master seed of the random streams
+    std::uint64_t configHash = 0; // Of gameSettings.json and entities.json; a replay warns when it differs
+    float tickRate = 0.0f;
+    std::string startAction;      // Menu action that started the recorded game
+};
+
+// Writes one InputFrame per simulation tick to a compact binary log: the
+// header, then runs of identical frames as (tick count, frame) records, so
+// held keys and a still mouse cost nothing per tick. Everything is little
+// endian.
+class InputRecorder
+{
+public:
+    ~InputRecorder() { close(); }
+
+    bool open(const std::string &path, const RecordingHeader &header);
+    void record(const InputFrame &frame);
+    void close();
+
+    bool isOpen() const { return file.is_open(); }
+    long getTickCount() const { return ticks; }
+
+private:
+    void writeRun();
+
+    std::ofstream file;
+    InputFrame runFrame;
+    std::uint32_t runLength = 0;
+    long ticks = 0;
+};
+
+// Reads a recording back one tick at a time
+class InputReplay
+{
+public:
+    bool open(const std::string &path);
+
+    // The next tick's input; false once the recording is used up
+    bool next(InputFrame &frame);
+
+    bool isOpen() const { return file.is_open(); }
+    const RecordingHeader &getHeader() const { return header; }
+
+private:
+    std::ifstream file;
+    RecordingHeader header;
+    InputFrame runFrame;
+    std::uint32_t runRemaining = 0;
+};
@@ -0,0 +1,179 @@
+#include "JobSystem.h"
+
+namespace
+{
+    thread_local unsigned currentThreadIndex = 0;
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+    : queues(new WorkQueue[workerCount + 1])
+{
+    for (unsigned i = 0; i < workerCount; i++)
+    {
+        workers.emplace_back(&JobSystem::workerLoop, this, i + 1);
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+unsigned JobSystem::threadIndex()
+{
+    return currentThreadIndex;
+}
+
+void JobSystem::submit(const Job &job)
+{
+    job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+    // Counted before it is visible so a thief can never take the count below zero
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    WorkQueue &queue = queues[threadIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    wakeWorkers(1);
+}
+
+void JobSystem::submitRange(std::size_t begin, std::size_t end, std::size_t grain,
+                            void (*run)(void *, std::size_t, std::size_t), void *context, JobCounter &counter)
+{
+    std::size_t count = (end - begin + grain - 1) / grain;
+    counter.pending.fetch_add(static_cast<int>(count), std::memory_order_relaxed);
+    queuedJobs.fetch_add(count, std::memory_order_release);
+
+    // Queue the pieces back to front so the owner pops them in order from the
+    // back while thieves take the far end of the range from the front
+    WorkQueue &queue = queues[threadIndex()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (std::size_t piece = count; piece-- > 0;)
+        {
+            Job job;
+            job.run = run;
+            job.context = context;
+            job.begin = begin + piece * grain;
+            job.end = job.begin + grain < end ? job.begin + grain : end;
+            job.counter = &counter;
+            queue.jobs.push_back(job);
+        }
+    }
+    wakeWorkers(count);
+}
+
+void JobSystem::wakeWorkers(std::size_t count)
+{
+    if (workers.empty())
+    {
+        return;
+    }
+
+    // Taking the lock orders this against a worker that has just found
+    // nothing to do and is about to sleep, so the wakeup can't be lost
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    if (count == 1)
+    {
+        workAvailable.notify_one();
+    }
+    else
+    {
+        workAvailable.notify_all();
+    }
+}
+
+bool JobSystem::takeJob(unsigned self, Job &job)
+{
+    if (queuedJobs.load(std::memory_order_acquire) == 0)
+    {
+        return false;
+    }
+
+    // Own work first, newest first (it is the most likely to be in cache)
+    {
+        WorkQueue &queue = queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty())
+        {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    // Then steal the oldest job from the next thread along
+    unsigned threadCount = getThreadCount();
+    for (unsigned offset = 1; offset < threadCount; offset++)
+    {
+        WorkQueue &victim = queues[(self + offset) % threadCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job &job)
+{
+    JobCounter *counter = job.counter;
+    job.run(job.context, job.begin, job.end);
+    counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::wait(JobCounter &counter)
+{
+    unsigned self = threadIndex();
+    while (!counter.done())
+    {
+        Job job;
+        if (takeJob(self, job))
+        {
+            execute(job);
+        }
+        else
+        {
+            // The remaining jobs are running on other threads
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::workerLoop(unsigned index)
+{
+    currentThreadIndex = index;
+    while (true)
+    {
+        Job job;
+        if (takeJob(index, job))
+        {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        workAvailable.wait(lock, [this]
+                           { return stopping || queuedJobs.load(std::memory_order_acquire) > 0; });
+        if (stopping)
+        {
+            return;
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Outstanding-job count for a batch; JobSystem::wait() returns once it hits zero
+class JobCounter
+{
+public:
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+};
+
+// A unit of work: run(context, begin, end). Plain data so batches of
+// parallelFor pieces can be queued without allocating per job.
+struct Job
+{
+    void (*run)(void *context, std::size_t begin, std::size_t end) = nullptr;
+    void *context = nullptr;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    JobCounter *counter = nullptr;
+};
+
+// Work-stealing thread pool. Every thread has its own deque: it pushes and
+// pops its own work at the back, and idle threads steal from the front of
+// other deques. Threads that wait on a counter keep executing jobs instead
+// of blocking, so jobs may themselves submit and wait (nested parallelFor).
+class JobSystem
+{
+public:
+    // workerCount 0 runs every job on the thread that waits for it
+    explicit JobSystem(unsigned workerCount);
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    void submit(const Job &job);
+
+    // Runs queued jobs until the counter's jobs have all finished
+    void wait(JobCounter &counter);
+
+    // Calls fn(first, last) over [begin, end) in pieces of at most `grain`
+    // items, possibly concurrently, and returns when all are done. Runs inline
+    // when the range fits in one piece.
+    template <typename Fn>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn &&fn);
+
+    // Calls fn(EntityID, Ts&...) for every entity of an ECS view, split by the
+    // view's blocks (driver rows or archetype chunks); `grain` counts blocks.
+    // fn runs concurrently and must only write the entity it is given.
+    template <typename View, typename Fn>
+    void parallelForEach(const View &view, std::size_t grain, Fn &&fn);
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(workers.size()); }
+
+    // Distinct values threadIndex() can return: the workers plus the
+    // (single) external thread that submits work
+    unsigned getThreadCount() const { return getWorkerCount() + 1; }
+
+    // 1..workerCount on worker threads, 0 anywhere else
+    static unsigned threadIndex();
+
+private:
+    struct alignas(64) WorkQueue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    void submitRange(std::size_t begin, std::size_t end, std::size_t grain,
+                     void (*run)(void *, std::size_t, std::size_t), void *context, JobCounter &counter);
+    bool takeJob(unsigned self, Job &job);
+    void execute(const Job &job);
+    void wakeWorkers(std::size_t count);
+    void workerLoop(unsigned index);
+
+    std::unique_ptr<WorkQueue[]> queues; // index 0 belongs to the external thread
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> queuedJobs{0};
+
+    std::mutex sleepMutex;
+    std::condition_variable workAvailable;
+    bool stopping = false;
+};
+
+// One T per job-system thread, each on its own cache line, so parallel jobs
+// can accumulate results (hit lists, counters) without locks and the caller
+// merges them after the parallelFor returns.
+template <typename T>
+class PerThread
+{
+public:
+    // A null job system means everything runs on the calling thread
+    explicit PerThread(const JobSystem *jobs) : slots(jobs ? jobs->getThreadCount() : 1) {}
+
+    T &local() { return slots[JobSystem::threadIndex()].value; }
+
+    std::size_t size() const { return slots.size(); }
+    T &operator[](std::size_t index) { return slots[index].value; }
+
+private:
+    struct alignas(64) Slot
+    {
+        T value;
+    };
+
+    std::vector<Slot> slots;
+};
+
+template <typename Fn>
+void JobSystem::parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Fn &&fn)
+{
+    if (grain == 0)
+    {
+        grain = 1;
+    }
+    if (end <= begin)
+    {
+        return;
+    }
+    if (workers.empty() || end - begin <= grain)
+    {
+        fn(begin, end);
+        return;
+    }
+
+    using Body = std::remove_reference_t<Fn>;
+    JobCounter counter;
+    submitRange(begin, end, grain, [](void *context, std::size_t first, std::size_t last)
+                { (*static_cast<Body *>(context))(first, last); },
+                const_cast<void *>(static_cast<const void *>(&fn)), counter);
+    wait(counter);
+}
+
+template <typename View, typename Fn>
+void JobSystem::parallelForEach(const View &view, std::size_t grain, Fn &&fn)
+{
+    parallelFor(0, view.blockCount(), grain, [&view, &fn](std::size_t first, std::size_t last)
+                { view.eachBlock(first, last, fn); });
+}
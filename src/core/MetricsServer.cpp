@@ -0,0 +1,211 @@
+#include "MetricsServer.h"
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+
+namespace
+{
+    // Waits this long for each scrape's request before giving up on it
+    const Uint32 REQUEST_TIMEOUT_MS = 1000;
+
+    // How often the server thread checks whether it should stop
+    const Uint32 ACCEPT_POLL_MS = 200;
+}
+
+MetricsServer::~MetricsServer()
+{
+    stop();
+}
+
+void MetricsServer::setPoolNames(const std::vector<const char *> &names)
+{
+    poolNames.assign(names.begin(), names.begin() + (names.size() < MetricsSnapshot::MAX_POOLS ? names.size() : MetricsSnapshot::MAX_POOLS));
+}
+
+bool MetricsServer::start(std::uint16_t port)
+{
+    if (SDLNet_Init() < 0)
+    {
+        std::cerr << "Metrics server: SDLNet_Init failed: " << SDLNet_GetError() << std::endl;
+        return false;
+    }
+
+    IPaddress address;
+    if (SDLNet_ResolveHost(&address, nullptr, port) < 0 || !(listener = SDLNet_TCP_Open(&address)))
+    {
+        std::cerr << "Metrics server: could not listen on port " << port << ": " << SDLNet_GetError() << std::endl;
+        SDLNet_Quit();
+        return false;
+    }
+    listenerSet = SDLNet_AllocSocketSet(1);
+    clientSet = SDLNet_AllocSocketSet(1);
+    SDLNet_TCP_AddSocket(listenerSet, listener);
+
+    response.resize(16384);
+    stopping = false;
+    thread = std::thread(&MetricsServer::serve, this);
+    std::cout << "Serving metrics on http://127.0.0.1:" << port << "/metrics" << std::endl;
+    return true;
+}
+
+void MetricsServer::stop()
+{
+    if (!thread.joinable())
+    {
+        return;
+    }
+
+    stopping = true;
+    thread.join();
+    SDLNet_TCP_Close(listener);
+    SDLNet_FreeSocketSet(listenerSet);
+    SDLNet_FreeSocketSet(clientSet);
+    listener = nullptr;
+    listenerSet = clientSet = nullptr;
+    SDLNet_Quit();
+}
+
+void MetricsServer::publish(const MetricsSnapshot &snapshot)
+{
+    // Fill the buffer only this thread touches, then swap it into the middle
+    buffers[writing] = snapshot;
+    writing = middle.exchange(writing | FRESH, std::memory_order_acq_rel) & ~FRESH;
+}
+
+const MetricsSnapshot &MetricsServer::latest()
+{
+    // Without a fresh snapshot, the one already held is still the newest
+    if (middle.load(std::memory_order_acquire) & FRESH)
+    {
+        reading = middle.exchange(reading, std::memory_order_acq_rel) & ~FRESH;
+    }
+    return buffers[reading];
+}
+
+void MetricsServer::serve()
+{
+    while (!stopping)
+    {
+        if (SDLNet_CheckSockets(listenerSet, ACCEPT_POLL_MS) <= 0 || !SDLNet_SocketReady(listener))
+        {
+            continue;
+        }
+
+        TCPsocket client = SDLNet_TCP_Accept(listener);
+        if (client)
+        {
+            respond(client);
+            SDLNet_TCP_Close(client);
+        }
+    }
+}
+
+void MetricsServer::respond(TCPsocket client)
+{
+    // The port is open on every interface, so turn away anything not local
+    IPaddress *peer = SDLNet_TCP_GetPeerAddress(client);
+    if (!peer || (SDLNet_Read32(&peer->host) >> 24) != 127)
+    {
+        return;
+    }
+
+    // Any request gets the metrics; it only has to arrive
+    SDLNet_TCP_AddSocket(clientSet, client);
+    bool ready = SDLNet_CheckSockets(clientSet, REQUEST_TIMEOUT_MS) > 0;
+    SDLNet_TCP_DelSocket(clientSet, client);
+    char request[1024];
+    if (!ready || SDLNet_TCP_Recv(client, request, sizeof(request)) <= 0)
+    {
+        return;
+    }
+
+    format(latest());
+    SDLNet_TCP_Send(client, response.data(), static_cast<int>(responseLength));
+}
+
+void MetricsServer::append(const char *format, ...)
+{
+    std::size_t space = response.size() - responseLength;
+    va_list arguments;
+    va_start(arguments, format);
+    int written = std::vsnprintf(response.data() + responseLength, space, format, arguments);
+    va_end(arguments);
+
+    // Text that doesn't fit is dropped rather than growing the buffer mid-scrape
+    if (written > 0)
+    {
+        responseLength += static_cast<std::size_t>(written) < space ? static_cast<std::size_t>(written) : space - 1;
+    }
+}
+
+void MetricsServer::format(const MetricsSnapshot &snapshot)
+{
+    responseLength = 0;
+    append("HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nConnection: close\r\n\r\n");
+
+    append("# HELP bloodstrike_uptime_seconds Time since the game started.\n"
+           "# TYPE bloodstrike_uptime_seconds gauge\n"
+           "bloodstrike_uptime_seconds %.3f\n", snapshot.uptimeSeconds);
+    append("# HELP bloodstrike_frames_total Frames run.\n"
+           "# TYPE bloodstrike_frames_total counter\n"
+           "bloodstrike_frames_total %ld\n", snapshot.frames);
+    append("# HELP bloodstrike_ticks_total Simulation ticks run.\n"
+           "# TYPE bloodstrike_ticks_total counter\n"
+           "bloodstrike_ticks_total %ld\n", snapshot.ticks);
+
+    append("# HELP bloodstrike_frame_time_milliseconds Frame time percentiles over the recent frames.\n"
+           "# TYPE bloodstrike_frame_time_milliseconds gauge\n"
+           "bloodstrike_frame_time_milliseconds{quantile=\"0.5\"} %.3f\n"
+           "bloodstrike_frame_time_milliseconds{quantile=\"0.95\"} %.3f\n"
+           "bloodstrike_frame_time_milliseconds{quantile=\"0.99\"} %.3f\n"
+           "bloodstrike_frame_time_milliseconds{quantile=\"1\"} %.3f\n",
+           snapshot.frameTimeP50, snapshot.frameTimeP95, snapshot.frameTimeP99, snapshot.frameTimeMax);
+    append("# HELP bloodstrike_frame_time_average_milliseconds Mean frame time over the recent frames.\n"
+           "# TYPE bloodstrike_frame_time_average_milliseconds gauge\n"
+           "bloodstrike_frame_time_average_milliseconds %.3f\n", snapshot.frameTimeAverage);
+
+    append("# HELP bloodstrike_pool_entities Entities in each component pool.\n"
+           "# TYPE bloodstrike_pool_entities gauge\n");
+    for (std::size_t pool = 0; pool < poolNames.size(); pool++)
+    {
+        append("bloodstrike_pool_entities{pool=\"%s\"} %u\n", poolNames[pool], snapshot.poolSizes[pool]);
+    }
+    append("# HELP bloodstrike_projectiles_alive Projectiles in flight.\n"
+           "# TYPE bloodstrike_projectiles_alive gauge\n"
+           "bloodstrike_projectiles_alive %u\n", snapshot.projectilesAlive);
+    append("# HELP bloodstrike_mobs_alive Mobs alive.\n"
+           "# TYPE bloodstrike_mobs_alive gauge\n"
+           "bloodstrike_mobs_alive %u\n", snapshot.mobsAlive);
+
+    append("# HELP bloodstrike_network_connected 1 while a peer is connected.\n"
+           "# TYPE bloodstrike_network_connected gauge\n"
+           "bloodstrike_network_connected %d\n", snapshot.networkConnected ? 1 : 0);
+    append("# HELP bloodstrike_network_rtt_milliseconds Smoothed heartbeat round trip (0 until measured).\n"
+           "# TYPE bloodstrike_network_rtt_milliseconds gauge\n"
+           "bloodstrike_network_rtt_milliseconds %.1f\n", snapshot.roundTripMilliseconds);
+    append("# HELP bloodstrike_network_messages_total Messages received and sent.\n"
+           "# TYPE bloodstrike_network_messages_total counter\n"
+           "bloodstrike_network_messages_total{direction=\"in\"} %llu\n"
+           "bloodstrike_network_messages_total{direction=\"out\"} %llu\n",
+           static_cast<unsigned long long>(snapshot.messagesReceived), static_cast<unsigned long long>(snapshot.messagesSent));
+    append("# HELP bloodstrike_network_bytes_total Bytes received and sent.\n"
+           "# TYPE bloodstrike_network_bytes_total counter\n"
+           "bloodstrike_network_bytes_total{direction=\"in\"} %llu\n"
+           "bloodstrike_network_bytes_total{direction=\"out\"} %llu\n",
+           static_cast<unsigned long long>(snapshot.bytesReceived), static_cast<unsigned long long>(snapshot.bytesSent));
+    append("# HELP bloodstrike_network_messages_per_second Message rate over the last publish interval.\n"
+           "# TYPE bloodstrike_network_messages_per_second gauge\n"
+           "bloodstrike_network_messages_per_second{direction=\"in\"} %.1f\n"
+           "bloodstrike_network_messages_per_second{direction=\"out\"} %.1f\n",
+           snapshot.messagesReceivedPerSecond, snapshot.messagesSentPerSecond);
+    append("# HELP bloodstrike_network_bytes_per_second Byte rate over the last publish interval.\n"
+           "# TYPE bloodstrike_network_bytes_per_second gauge\n"
+           "bloodstrike_network_bytes_per_second{direction=\"in\"} %.1f\n"
+           "bloodstrike_network_bytes_per_second{direction=\"out\"} %.1f\n",
+           snapshot.bytesReceivedPerSecond, snapshot.bytesSentPerSecond);
+    append("# HELP bloodstrike_network_queue_depth Messages waiting when each queue was last drained.\n"
+           "# TYPE bloodstrike_network_queue_depth gauge\n"
+           "bloodstrike_network_queue_depth{queue=\"incoming\"} %u\n"
+           "bloodstrike_network_queue_depth{queue=\"outgoing\"} %u\n",
+           snapshot.incomingQueueDepth, snapshot.outgoingQueueDepth);
+}
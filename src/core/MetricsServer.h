@@ -0,0 +1,82 @@
+#pragma once
+#include <SDL2/SDL_net.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// One moment of the game's telemetry, filled in by the main loop. Plain data
+// so publishing it is a copy.
+struct MetricsSnapshot
+{
+    static constexpr int MAX_POOLS = 16;
+
+    double uptimeSeconds;
+    long frames;
+    long ticks;
+
+    // Over TimingSystem's recent frame window, in milliseconds
+    float frameTimeAverage, frameTimeP50, frameTimeP95, frameTimeP99, frameTimeMax;
+
+    std::uint32_t poolSizes[MAX_POOLS]; // Columns named by setPoolNames()
+    std::uint32_t projectilesAlive;
+    std::uint32_t mobsAlive;
+
+    bool networkConnected;
+    float roundTripMilliseconds;
+    std::uint64_t messagesReceived, messagesSent; // Totals since start-up
+    std::uint64_t bytesReceived, bytesSent;
+    float messagesReceivedPerSecond, messagesSentPerSecond; // Since the previous snapshot
+    float bytesReceivedPerSecond, bytesSentPerSecond;
+    std::uint32_t incomingQueueDepth, outgoingQueueDepth;
+};
+
+// Serves the latest snapshot as Prometheus text over HTTP on a local port.
+// The main loop publish()es snapshots into a triple buffer and a background
+// thread picks up the newest one per scrape, so neither side ever waits for
+// the other. Only loopback clients are answered.
+class MetricsServer
+{
+public:
+    MetricsServer() = default;
+    ~MetricsServer();
+
+    MetricsServer(const MetricsServer &) = delete;
+    MetricsServer &operator=(const MetricsServer &) = delete;
+
+    // Names of the poolSizes entries; call before start(), must outlive the server
+    void setPoolNames(const std::vector<const char *> &names);
+
+    bool start(std::uint16_t port);
+    void stop();
+
+    // Main thread only
+    void publish(const MetricsSnapshot &snapshot);
+
+private:
+    static constexpr unsigned FRESH = 4; // Set on `middle` when it holds an unread snapshot
+
+    void serve();
+    void respond(TCPsocket client);
+    const MetricsSnapshot &latest();
+    void format(const MetricsSnapshot &snapshot);
+    void append(const char *format, ...);
+
+    MetricsSnapshot buffers[3] = {};
+    std::atomic<unsigned> middle{1};
+    unsigned writing = 0; // Main thread's buffer
+    unsigned reading = 2; // Server thread's buffer
+
+    std::vector<const char *> poolNames;
+
+    TCPsocket listener = nullptr;
+    SDLNet_SocketSet listenerSet = nullptr;
+    SDLNet_SocketSet clientSet = nullptr;
+    std::thread thread;
+    std::atomic<bool> stopping{false};
+
+    // Response text, reused between scrapes
+    std::vector<char> response;
+    std::size_t responseLength = 0;
+};
@@ -0,0 +1,181 @@
+#include "Profiler.h"
+
+#ifdef BLOODSTRIKE_PROFILING
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+    thread_local void *currentBuffer = nullptr;
+
+    // Weight of the newest frame in the overlay's running averages
+    constexpr float SMOOTHING = 0.1f;
+
+    void writeJSONString(std::ostream &out, const char *text)
+    {
+        out << '"';
+        for (const char *c = text; *c != '\0'; c++)
+        {
+            if (*c == '"' || *c == '\\')
+            {
+                out << '\\';
+            }
+            out << *c;
+        }
+        out << '"';
+    }
+}
+
+Profiler::ThreadBuffer &Profiler::localBuffer()
+{
+    if (!currentBuffer)
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffers.push_back(std::make_unique<ThreadBuffer>());
+        buffers.back()->thread = static_cast<unsigned>(buffers.size() - 1);
+        currentBuffer = buffers.back().get();
+    }
+    return *static_cast<ThreadBuffer *>(currentBuffer);
+}
+
+void Profiler::record(const char *name, std::uint64_t start, std::uint64_t end)
+{
+    ThreadBuffer &buffer = localBuffer();
+    buffer.events.push_back({name, start, end, buffer.thread});
+}
+
+void Profiler::newFrame()
+{
+    // The main thread registers first, so it is thread 0 in traces
+    localBuffer();
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    if (frameIndex >= 0)
+    {
+        closeFrame();
+    }
+    for (std::unique_ptr<ThreadBuffer> &buffer : buffers)
+    {
+        buffer->events.clear();
+    }
+
+    frameIndex++;
+    frameStart = now();
+}
+
+void Profiler::closeFrame()
+{
+    ThreadBuffer &mainBuffer = *static_cast<ThreadBuffer *>(currentBuffer);
+    mainBuffer.events.push_back({"frame", frameStart, now(), mainBuffer.thread});
+
+    // Total each scope's time this frame; the same name from different
+    // translation units may be different pointers, so names are compared
+    std::fill(frameMilliseconds.begin(), frameMilliseconds.end(), 0.0f);
+    bool tracing = isCapturing() && frameIndex >= traceFirstFrame && frameIndex < traceEndFrame;
+    for (std::unique_ptr<ThreadBuffer> &buffer : buffers)
+    {
+        for (const Event &event : buffer->events)
+        {
+            std::size_t scope = 0;
+            while (scope < scopeTimes.size() && std::strcmp(scopeTimes[scope].name, event.name) != 0)
+            {
+                scope++;
+            }
+            if (scope == scopeTimes.size())
+            {
+                scopeTimes.push_back({event.name, 0.0f});
+                frameMilliseconds.push_back(0.0f);
+            }
+            frameMilliseconds[scope] += (event.end - event.start) * 1e-6f;
+        }
+
+        if (tracing)
+        {
+            traceEvents.insert(traceEvents.end(), buffer->events.begin(), buffer->events.end());
+        }
+    }
+
+    for (std::size_t scope = 0; scope < scopeTimes.size(); scope++)
+    {
+        scopeTimes[scope].milliseconds += (frameMilliseconds[scope] - scopeTimes[scope].milliseconds) * SMOOTHING;
+    }
+
+    if (isCapturing() && frameIndex + 1 >= traceEndFrame)
+    {
+        writeTrace();
+    }
+}
+
+void Profiler::captureTrace(const std::string &path, long firstFrame, long frameCount)
+{
+    if (frameCount <= 0 || path.empty())
+    {
+        return;
+    }
+
+    // Frames already finished can't be traced any more
+    long earliest = frameIndex > 0 ? frameIndex : 0;
+    tracePath = path;
+    traceFirstFrame = firstFrame > earliest ? firstFrame : earliest;
+    traceEndFrame = traceFirstFrame + frameCount;
+    traceEvents.clear();
+    std::cout << "Tracing frames " << traceFirstFrame << " to " << traceEndFrame - 1 << " into " << path << std::endl;
+}
+
+void Profiler::finishTrace()
+{
+    if (isCapturing())
+    {
+        writeTrace();
+    }
+}
+
+void Profiler::writeTrace()
+{
+    std::ofstream file(tracePath);
+    if (!file.is_open())
+    {
+        std::cerr << "Could not write trace: " << tracePath << std::endl;
+    }
+    else
+    {
+        // Thread names, then complete ("X") events in microseconds
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        for (std::size_t thread = 0; thread < buffers.size(); thread++)
+        {
+            file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":\"";
+            if (thread == 0)
+            {
+                file << "main";
+            }
+            else
+            {
+                file << "thread " << thread;
+            }
+            file << "\"}},\n";
+        }
+
+        file << std::fixed << std::setprecision(3);
+        for (const Event &event : traceEvents)
+        {
+            file << "{\"name\":";
+            writeJSONString(file, event.name);
+            file << ",\"cat\":\"bloodstrike\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+                 << ",\"ts\":" << event.start * 1e-3 << ",\"dur\":" << (event.end - event.start) * 1e-3 << "},\n";
+        }
+
+        // A closing marker, so every real entry above can end with a comma
+        file << "{\"name\":\"trace end\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":"
+             << now() * 1e-3 << "}\n]}\n";
+        std::cout << "Wrote " << traceEvents.size() << " trace events to " << tracePath << std::endl;
+    }
+
+    tracePath.clear();
+    traceEvents.clear();
+    traceEvents.shrink_to_fit();
+}
+
+#endif
@@ -0,0 +1,121 @@
+#pragma once
+
+// Frame profiler. PROFILE_SCOPE("name") times the rest of the enclosing block
+// on whichever thread runs it, and PROFILE_FRAME() at the top of the game
+// loop closes the previous frame. Names must be string literals; they are
+// kept by pointer. Built only with BLOODSTRIKE_PROFILING: without it the
+// macros expand to nothing and the profiler itself is compiled out.
+#ifdef BLOODSTRIKE_PROFILING
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FRAME() Profiler::getInstance().newFrame()
+
+class Profiler
+{
+public:
+    static Profiler &getInstance()
+    {
+        static Profiler instance;
+        return instance;
+    }
+
+    // Nanoseconds since the profiler started
+    std::uint64_t now() const
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime).count());
+    }
+
+    void record(const char *name, std::uint64_t start, std::uint64_t end);
+
+    // Ends the current frame and starts the next. Must run on the main thread
+    // while no profiled work is in flight on other threads.
+    void newFrame();
+
+    // The frame in progress; the first frame is 0
+    long getFrameIndex() const { return frameIndex; }
+
+    // Writes frames [firstFrame, firstFrame + frameCount) as a Chrome
+    // trace_event JSON file (chrome://tracing, ui.perfetto.dev)
+    void captureTrace(const std::string &path, long firstFrame, long frameCount);
+    bool isCapturing() const { return !tracePath.empty(); }
+
+    // Writes whatever a capture has collected so far; for shutdown
+    void finishTrace();
+
+    // Milliseconds per frame spent in each scope, smoothed over recent frames,
+    // in the order the scopes were first seen
+    struct ScopeTime
+    {
+        const char *name;
+        float milliseconds;
+    };
+    const std::vector<ScopeTime> &getScopeTimes() const { return scopeTimes; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Event
+    {
+        const char *name;
+        std::uint64_t start, end;
+        unsigned thread;
+    };
+
+    // Each thread appends to its own buffer, so recording takes no lock
+    struct ThreadBuffer
+    {
+        unsigned thread;
+        std::vector<Event> events;
+    };
+
+    Profiler() : startTime(Clock::now()) {}
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    ThreadBuffer &localBuffer();
+    void closeFrame();
+    void writeTrace();
+
+    Clock::time_point startTime;
+    std::mutex buffersMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    long frameIndex = -1;
+    std::uint64_t frameStart = 0;
+    std::vector<ScopeTime> scopeTimes;
+    std::vector<float> frameMilliseconds; // scratch, parallel to scopeTimes
+
+    std::string tracePath;
+    long traceFirstFrame = 0, traceEndFrame = 0;
+    std::vector<Event> traceEvents;
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char *name) : name(name), start(Profiler::getInstance().now()) {}
+    ~ProfileScope() { Profiler::getInstance().record(name, start, Profiler::getInstance().now()); }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *name;
+    std::uint64_t start;
+};
+
+#else
+
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FRAME() ((void)0)
+
+#endif
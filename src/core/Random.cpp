@@ -0,0 +1,34 @@
+#include "Random.h"
+#include <chrono>
+#include <random>
+
+namespace
+{
+    // splitmix64 finaliser: spreads nearby inputs over the whole range
+    std::uint64_t mix(std::uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ull;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+}
+
+std::uint32_t streamSeed(std::uint64_t masterSeed, const char *streamName)
+{
+    // FNV-1a of the name, so streams don't depend on registration order
+    std::uint64_t nameHash = 0xCBF29CE484222325ull;
+    for (const char *c = streamName; *c != '\0'; c++)
+    {
+        nameHash = (nameHash ^ static_cast<unsigned char>(*c)) * 0x100000001B3ull;
+    }
+
+    return static_cast<std::uint32_t>(mix(masterSeed ^ mix(nameHash)) >> 32);
+}
+
+std::uint64_t randomMasterSeed()
+{
+    std::random_device device;
+    std::uint64_t entropy = (static_cast<std::uint64_t>(device()) << 32) | device();
+    return mix(entropy ^ static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count()));
+}
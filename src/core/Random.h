@@ -0,0 +1,12 @@
+#pragma once
+#include <cstdint>
+
+// Seeds for independent random streams cut from one master seed. Each
+// consumer names its stream, so drawing more or fewer numbers in one system
+// never shifts what another sees, and a fixed master seed replays every
+// stream exactly (within one build; the standard distributions may differ
+// between standard libraries).
+std::uint32_t streamSeed(std::uint64_t masterSeed, const char *streamName);
+
+// A master seed that differs from run to run, for normal play
+std::uint64_t randomMasterSeed();
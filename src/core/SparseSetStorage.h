@@ -0,0 +1,356 @@
+#pragma once
+#include "ECSTypes.h"
+#include <vector>
+#include <array>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <algorithm>
+
+class ComponentPool {
+public:
+    virtual ~ComponentPool() = default;
+    virtual void remove(EntityID entity) = 0;
+    virtual void removeMany(const std::vector<EntityID>& entities) = 0;
+};
+
+// Sparse-set storage: components live packed in a dense array with a parallel
+// dense entity array. A paged sparse index maps the entity's slot index -> dense
+// slot, so lookups are two array reads and iteration walks contiguous memory.
+// The dense entity array keeps full handles, which is how stale handles are
+// rejected: a recycled slot maps to a handle with a different generation.
+template<typename T>
+class ComponentPoolTyped : public ComponentPool {
+private:
+    static constexpr std::size_t PAGE_SIZE = 1024;
+    static constexpr std::size_t INVALID_INDEX = static_cast<std::size_t>(-1);
+    using Page = std::array<std::size_t, PAGE_SIZE>;
+
+    std::vector<T> components;                // dense, packed
+    std::vector<EntityID> entities;           // dense, parallel to components
+    std::vector<std::unique_ptr<Page>> sparse; // entity index -> dense index, allocated per page
+
+    std::size_t* sparseSlot(EntityID entity) const {
+        std::size_t index = entityIndex(entity);
+        std::size_t page = index / PAGE_SIZE;
+        if (page >= sparse.size() || !sparse[page]) {
+            return nullptr;
+        }
+        return &(*sparse[page])[index % PAGE_SIZE];
+    }
+
+    // Dense slot owned by exactly this handle, or nullptr (missing or stale)
+    std::size_t* liveSlot(EntityID entity) const {
+        std::size_t* slot = sparseSlot(entity);
+        if (!slot || *slot == INVALID_INDEX || entities[*slot] != entity) {
+            return nullptr;
+        }
+        return slot;
+    }
+
+    std::size_t& sparseSlotOrCreate(EntityID entity) {
+        std::size_t index = entityIndex(entity);
+        std::size_t page = index / PAGE_SIZE;
+        if (page >= sparse.size()) {
+            sparse.resize(page + 1);
+        }
+        if (!sparse[page]) {
+            sparse[page] = std::make_unique<Page>();
+            sparse[page]->fill(INVALID_INDEX);
+        }
+        return (*sparse[page])[index % PAGE_SIZE];
+    }
+
+public:
+    // Iterates (EntityID, T&) pairs in dense order so existing
+    // `for (auto &[entity, component] : pool)` loops keep working.
+    class iterator {
+    private:
+        ComponentPoolTyped* pool;
+        std::size_t index;
+        std::optional<std::pair<EntityID, T&>> current;
+
+    public:
+        iterator(ComponentPoolTyped* pool, std::size_t index) : pool(pool), index(index) {}
+
+        std::pair<EntityID, T&>& operator*() {
+            current.emplace(pool->entities[index], pool->components[index]);
+            return *current;
+        }
+
+        iterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+
+    void add(EntityID entity, T component) {
+        std::size_t& slot = sparseSlotOrCreate(entity);
+        if (slot != INVALID_INDEX) {
+            // Same slot index: either this entity or a stale previous occupant
+            components[slot] = std::move(component);
+            entities[slot] = entity;
+            return;
+        }
+        slot = components.size();
+        components.push_back(std::move(component));
+        entities.push_back(entity);
+    }
+
+    T* get(EntityID entity) {
+        std::size_t* slot = liveSlot(entity);
+        return slot ? &components[*slot] : nullptr;
+    }
+
+    bool contains(EntityID entity) const {
+        return liveSlot(entity) != nullptr;
+    }
+
+    // O(1) swap-and-pop: the last element fills the hole
+    void remove(EntityID entity) override {
+        std::size_t* slot = liveSlot(entity);
+        if (!slot) {
+            return;
+        }
+
+        std::size_t removed = *slot;
+        std::size_t last = components.size() - 1;
+        if (removed != last) {
+            components[removed] = std::move(components[last]);
+            entities[removed] = entities[last];
+            *sparseSlot(entities[removed]) = removed;
+        }
+        components.pop_back();
+        entities.pop_back();
+        *slot = INVALID_INDEX;
+    }
+
+    // Batched removal: one virtual call per pool instead of one per entity
+    void removeMany(const std::vector<EntityID>& toRemove) override {
+        for (EntityID entity : toRemove) {
+            ComponentPoolTyped::remove(entity);
+        }
+    }
+
+    // Contiguous component storage; getEntities()[i] owns getAll()[i]
+    std::vector<T>& getAll() {
+        return components;
+    }
+
+    const std::vector<EntityID>& getEntities() const {
+        return entities;
+    }
+
+    std::size_t size() const { return components.size(); }
+    bool empty() const { return components.empty(); }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, components.size()); }
+};
+
+// Multi-component join. Iteration is driven by the smallest of the requested
+// pools; entities whose signature lacks any other component, or that are queued
+// for removal in the command buffer, are skipped. Yields
+// (EntityID, Ts&...) tuples, e.g.
+//   for (auto [entity, transform, velocity] : ecs.view<Transform, Velocity>())
+// Entities must not be added to or removed from the viewed pools while iterating;
+// use ecs.commands() to defer those changes.
+template<typename... Ts>
+class SparseSetView {
+private:
+    static_assert((!isTagComponent<Ts> || ...), "tag-only views are TagViews");
+
+    // Tags have no pool; their membership is checked through the signature
+    template<typename T>
+    using PoolPointer = std::conditional_t<isTagComponent<T>, std::nullptr_t, ComponentPoolTyped<T>*>;
+
+    std::tuple<PoolPointer<Ts>...> pools;
+    const std::vector<EntityID>* driver = nullptr;
+    const std::vector<ComponentSignature>* signatures;
+    ComponentSignature required;
+    ComponentSignature mask; // required components plus the pending-removal bit
+
+    bool containsAll(EntityID entity) const {
+        return ((*signatures)[entityIndex(entity)] & mask) == required;
+    }
+
+    template<typename T, std::size_t I>
+    T& fetch(EntityID entity) const {
+        if constexpr (isTagComponent<T>) {
+            return tagInstance<T>();
+        } else {
+            return *std::get<I>(pools)->get(entity);
+        }
+    }
+
+    template<std::size_t... Is>
+    std::tuple<EntityID, Ts&...> fetchAll(EntityID entity, std::index_sequence<Is...>) const {
+        return std::tuple<EntityID, Ts&...>(entity, fetch<Ts, Is>(entity)...);
+    }
+
+    void considerDriver(std::nullptr_t, std::size_t&) {}
+
+    template<typename T>
+    void considerDriver(ComponentPoolTyped<T>* pool, std::size_t& smallest) {
+        if (pool->size() < smallest) {
+            smallest = pool->size();
+            driver = &pool->getEntities();
+        }
+    }
+
+public:
+    class iterator {
+    private:
+        const SparseSetView* view;
+        std::size_t index;
+
+        void skipMissing() {
+            const std::vector<EntityID>& entities = *view->driver;
+            while (index < entities.size() && !view->containsAll(entities[index])) {
+                ++index;
+            }
+        }
+
+    public:
+        iterator(const SparseSetView* view, std::size_t index) : view(view), index(index) { skipMissing(); }
+
+        std::tuple<EntityID, Ts&...> operator*() const {
+            return view->fetchAll((*view->driver)[index], std::index_sequence_for<Ts...>{});
+        }
+
+        iterator& operator++() {
+            ++index;
+            skipMissing();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+
+    SparseSetView(const std::vector<ComponentSignature>& signatures, PoolPointer<Ts>... typedPools)
+        : pools(typedPools...), signatures(&signatures), required(componentSignature<Ts...>()),
+          mask(ComponentSignature(required).set(PENDING_REMOVAL_BIT)) {
+        // Drive from the smallest data pool; ties keep the first requested type
+        std::size_t smallest = static_cast<std::size_t>(-1);
+        (considerDriver(typedPools, smallest), ...);
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, driver->size()); }
+
+    // Calls fn(EntityID, Ts&...) for every matching entity
+    template<typename Fn>
+    void each(Fn&& fn) const {
+        for (auto it = begin(); it != end(); ++it) {
+            std::apply(fn, *it);
+        }
+    }
+
+    // Driver rows split into fixed blocks so jobs can walk disjoint parts of
+    // the view concurrently (JobSystem::parallelForEach)
+    static constexpr std::size_t BLOCK_ROWS = 256;
+
+    std::size_t blockCount() const { return (driver->size() + BLOCK_ROWS - 1) / BLOCK_ROWS; }
+
+    // each() restricted to blocks [first, last)
+    template<typename Fn>
+    void eachBlock(std::size_t first, std::size_t last, Fn&& fn) const {
+        std::size_t end = std::min(last * BLOCK_ROWS, driver->size());
+        for (std::size_t index = first * BLOCK_ROWS; index < end; ++index) {
+            EntityID entity = (*driver)[index];
+            if (containsAll(entity)) {
+                std::apply(fn, fetchAll(entity, std::index_sequence_for<Ts...>{}));
+            }
+        }
+    }
+};
+
+// Default storage backend: one sparse-set pool per component type
+class SparseSetStorage {
+private:
+    std::vector<std::unique_ptr<ComponentPool>> componentPools; // indexed by componentTypeID, null until first use
+    std::vector<EntityID> removalScratch;
+
+    template<typename T>
+    auto poolPointer() {
+        if constexpr (isTagComponent<T>) {
+            return nullptr;
+        } else {
+            return &components<T>();
+        }
+    }
+
+public:
+    template<typename T>
+    ComponentPoolTyped<T>& components() {
+        ComponentTypeID id = componentTypeID<T>();
+        if (id >= componentPools.size()) {
+            componentPools.resize(id + 1);
+        }
+        if (!componentPools[id]) {
+            componentPools[id] = std::make_unique<ComponentPoolTyped<T>>();
+        }
+        return *static_cast<ComponentPoolTyped<T>*>(componentPools[id].get());
+    }
+
+    template<typename T>
+    void add(EntityID entity, T component) {
+        components<T>().add(entity, std::move(component));
+    }
+
+    template<typename T>
+    T* get(EntityID entity) {
+        ComponentTypeID id = componentTypeID<T>();
+        if (id >= componentPools.size() || !componentPools[id]) {
+            return nullptr;
+        }
+        return static_cast<ComponentPoolTyped<T>*>(componentPools[id].get())->get(entity);
+    }
+
+    template<typename T>
+    void remove(EntityID entity) {
+        components<T>().remove(entity);
+    }
+
+    // Only visits the pools named in the entity's signature
+    void removeEntity(EntityID entity, const ComponentSignature& signature) {
+        for (ComponentTypeID id = 0; id < componentPools.size(); ++id) {
+            if (signature.test(id) && componentPools[id]) {
+                componentPools[id]->remove(entity);
+            }
+        }
+    }
+
+    // Removals grouped per pool; signatures are indexed by entity index
+    void removeEntities(const std::vector<EntityID>& entities, const std::vector<ComponentSignature>& signatures) {
+        for (ComponentTypeID id = 0; id < componentPools.size(); ++id) {
+            if (!componentPools[id]) {
+                continue;
+            }
+            removalScratch.clear();
+            for (EntityID entity : entities) {
+                if (signatures[entityIndex(entity)].test(id)) {
+                    removalScratch.push_back(entity);
+                }
+            }
+            if (!removalScratch.empty()) {
+                componentPools[id]->removeMany(removalScratch);
+            }
+        }
+    }
+
+    template<typename T>
+    std::vector<EntityID> entitiesWith() {
+        return components<T>().getEntities();
+    }
+
+    template<typename... Ts>
+    SparseSetView<Ts...> view(const std::vector<ComponentSignature>& signatures) {
+        return SparseSetView<Ts...>(signatures, poolPointer<Ts>()...);
+    }
+};
@@ -0,0 +1,90 @@
+#include "StateHash.h"
+#include "../components/Components.h"
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    // FNV-1a, fed field by field so struct padding never reaches the hash
+    class StateHasher
+    {
+    public:
+        void add(std::uint32_t value)
+        {
+            for (int byte = 0; byte < 4; byte++)
+            {
+                hash = (hash ^ ((value >> (byte * 8)) & 0xFFu)) * 0x100000001B3ull;
+            }
+        }
+
+        void add(float value)
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            add(bits);
+        }
+
+        void add(int value) { add(static_cast<std::uint32_t>(value)); }
+        void add(bool value) { add(static_cast<std::uint32_t>(value)); }
+
+        std::uint64_t value() const { return hash; }
+
+    private:
+        std::uint64_t hash = 0xCBF29CE484222325ull;
+    };
+
+    // Dense per-call number for each entity, in the order first asked for
+    class EntityOrdinals
+    {
+    public:
+        explicit EntityOrdinals(std::size_t capacity) : ordinals(capacity, UNSET) {}
+
+        std::uint32_t of(EntityID entity)
+        {
+            std::uint32_t &ordinal = ordinals[entityIndex(entity)];
+            if (ordinal == UNSET)
+            {
+                ordinal = next++;
+            }
+            return ordinal;
+        }
+
+    private:
+        static constexpr std::uint32_t UNSET = ~0u;
+        std::vector<std::uint32_t> ordinals; // by entity index
+        std::uint32_t next = 0;
+    };
+}
+
+std::uint64_t hashSimulationState(ECS &ecs)
+{
+    StateHasher hasher;
+    EntityOrdinals ordinals(ecs.capacity());
+
+    ecs.view<Transform>().each([&hasher, &ordinals](EntityID entity, Transform &transform)
+                               {
+        hasher.add(ordinals.of(entity));
+        hasher.add(transform.x);
+        hasher.add(transform.y);
+        hasher.add(transform.rotation); });
+
+    ecs.view<Health>().each([&hasher, &ordinals](EntityID entity, Health &health)
+                            {
+        hasher.add(ordinals.of(entity));
+        hasher.add(health.currentHealth);
+        hasher.add(health.maxHealth); });
+
+    ecs.view<Weapon>().each([&hasher, &ordinals](EntityID entity, Weapon &weapon)
+                            {
+        hasher.add(ordinals.of(entity));
+        hasher.add(weapon.damage);
+        hasher.add(weapon.fireRate);
+        hasher.add(weapon.ammoCount);
+        hasher.add(weapon.maxAmmo);
+        hasher.add(weapon.range);
+        hasher.add(weapon.fireTimer);
+        hasher.add(weapon.canFire);
+        hasher.add(weapon.hitscan); });
+
+    return hasher.value();
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "ECS.h"
+#include <cstdint>
+
+// Fingerprint of the simulation state: every entity's Transform, Health and
+// Weapon, hashed in storage order. Entities are told apart by the order they
+// are first met rather than by handle, since handles also count entities made
+// before play (menu items a replay never creates). Two runs from the same seed
+// and inputs produce the same sequence of hashes, so the first tick where
+// they differ pins down where a desync or nondeterminism crept in.
+// Render-only state (sprites, animation, interpolation snapshots) is left out.
+std::uint64_t hashSimulationState(ECS &ecs);
@@ -0,0 +1,147 @@
+#include "SystemScheduler.h"
+#include "Profiler.h"
+#include <chrono>
+#include <cstring>
+
+bool SystemAccess::conflictsWith(const SystemAccess &other) const
+{
+    if ((writes & (other.reads | other.writes)).any() || (other.writes & reads).any())
+    {
+        return true;
+    }
+    return (writeResources & (other.readResources | other.writeResources)).any() ||
+           (other.writeResources & readResources).any();
+}
+
+SystemScheduler::SystemScheduler(JobSystem &jobs)
+    : jobs(jobs)
+{
+}
+
+void SystemScheduler::add(const char *name, const SystemAccess &access, std::function<void()> run)
+{
+    Task task;
+    task.name = name;
+    task.access = access;
+    task.run = std::move(run);
+
+    // Anything that looks at components must not overlap entity creation/removal
+    if (access.reads.any() || access.writes.any())
+    {
+        task.access.read(SystemResource::Structural);
+    }
+
+    std::size_t index = tasks.size();
+    for (std::size_t earlier = 0; earlier < index; earlier++)
+    {
+        if (tasks[earlier].access.conflictsWith(task.access))
+        {
+            tasks[earlier].dependents.push_back(index);
+            task.dependencyCount++;
+        }
+    }
+    tasks.push_back(std::move(task));
+}
+
+void SystemScheduler::run()
+{
+    if (tasks.empty())
+    {
+        return;
+    }
+
+    // Without workers, the order tasks were added in is a valid topological order
+    if (jobs.getWorkerCount() == 0)
+    {
+        for (Task &task : tasks)
+        {
+            timeTask(task);
+        }
+        finishRun();
+        return;
+    }
+
+    if (remainingCapacity < tasks.size())
+    {
+        remaining.reset(new std::atomic<int>[tasks.size()]);
+        remainingCapacity = tasks.size();
+    }
+    for (std::size_t i = 0; i < tasks.size(); i++)
+    {
+        remaining[i].store(tasks[i].dependencyCount, std::memory_order_relaxed);
+    }
+
+    for (std::size_t i = 0; i < tasks.size(); i++)
+    {
+        if (tasks[i].dependencyCount == 0)
+        {
+            submit(i);
+        }
+    }
+
+    // Dependents are submitted before the task that released them finishes,
+    // so the frame counter only reaches zero once every task has run
+    jobs.wait(frame);
+    finishRun();
+}
+
+void SystemScheduler::timeTask(Task &task)
+{
+    PROFILE_SCOPE(task.name);
+    auto start = std::chrono::steady_clock::now();
+    task.run();
+    task.milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void SystemScheduler::finishRun()
+{
+    for (const Task &task : tasks)
+    {
+        // Names are usually the same literal every frame, so compare pointers first
+        std::size_t slot = 0;
+        while (slot < systemTimes.size() && systemTimes[slot].name != task.name &&
+               std::strcmp(systemTimes[slot].name, task.name) != 0)
+        {
+            slot++;
+        }
+        if (slot == systemTimes.size())
+        {
+            systemTimes.push_back({task.name, 0.0f});
+        }
+        systemTimes[slot].milliseconds += task.milliseconds;
+    }
+    tasks.clear();
+}
+
+void SystemScheduler::resetSystemTimes()
+{
+    for (SystemTime &time : systemTimes)
+    {
+        time.milliseconds = 0.0f;
+    }
+}
+
+void SystemScheduler::submit(std::size_t taskIndex)
+{
+    Job job;
+    job.run = &SystemScheduler::runTask;
+    job.context = this;
+    job.begin = taskIndex;
+    job.counter = &frame;
+    jobs.submit(job);
+}
+
+void SystemScheduler::runTask(void *context, std::size_t taskIndex, std::size_t)
+{
+    SystemScheduler *scheduler = static_cast<SystemScheduler *>(context);
+    Task &task = scheduler->tasks[taskIndex];
+    timeTask(task);
+
+    for (std::size_t dependent : task.dependents)
+    {
+        if (scheduler->remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            scheduler->submit(dependent);
+        }
+    }
+}
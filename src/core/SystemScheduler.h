@@ -0,0 +1,123 @@
+#pragma once
+#include "ECSTypes.h"
+#include "JobSystem.h"
+#include <atomic>
+#include <bitset>
+#include <memory>
+#include <vector>
+#include <functional>
+
+// Shared non-ECS state a system can touch. Structural covers entity
+// creation/removal and the ECS command buffer; every system that reads
+// components implicitly reads it, so structural writers act as barriers.
+enum class SystemResource
+{
+    GameState,  // GameManager
+    Network,    // NetworkSystem send queues and entity maps
+    Audio,      // AudioSystem / SDL_mixer
+    Input,      // the tick's InputFrame (keyboard and mouse)
+    Broadphase, // spatial index rebuilt each frame by BroadphaseSystem
+    Contacts,   // per-frame contact list filled by CollisionSystem
+    Structural,
+    Count
+};
+
+using ResourceMask = std::bitset<static_cast<std::size_t>(SystemResource::Count)>;
+
+// Components and resources a system reads and writes during update()
+struct SystemAccess
+{
+    ComponentSignature reads;
+    ComponentSignature writes;
+    ResourceMask readResources;
+    ResourceMask writeResources;
+
+    template <typename... Ts>
+    SystemAccess &read()
+    {
+        reads |= componentSignature<Ts...>();
+        return *this;
+    }
+
+    template <typename... Ts>
+    SystemAccess &write()
+    {
+        writes |= componentSignature<Ts...>();
+        return *this;
+    }
+
+    SystemAccess &read(SystemResource resource)
+    {
+        readResources.set(static_cast<std::size_t>(resource));
+        return *this;
+    }
+
+    SystemAccess &write(SystemResource resource)
+    {
+        writeResources.set(static_cast<std::size_t>(resource));
+        return *this;
+    }
+
+    // Writes every component and resource; the default for undeclared systems
+    static SystemAccess exclusive()
+    {
+        SystemAccess access;
+        access.writes.set();
+        access.writeResources.set();
+        return access;
+    }
+
+    bool conflictsWith(const SystemAccess &other) const;
+};
+
+// Runs one frame's systems as a dependency graph. Each system added depends on
+// every earlier system whose access conflicts with it, so the serial order in
+// which systems are added is preserved wherever it matters, while systems with
+// disjoint data run concurrently as jobs on the JobSystem (the caller helps).
+class SystemScheduler
+{
+public:
+    // A job system without workers runs everything inline in add order
+    explicit SystemScheduler(JobSystem &jobs);
+
+    SystemScheduler(const SystemScheduler &) = delete;
+    SystemScheduler &operator=(const SystemScheduler &) = delete;
+
+    void add(const char *name, const SystemAccess &access, std::function<void()> run);
+
+    // Executes everything added since the last run() and blocks until done
+    void run();
+
+    // Wall time each system has spent in run() since the last reset, in the
+    // order systems were first seen; read on the thread that calls run()
+    struct SystemTime
+    {
+        const char *name;
+        float milliseconds;
+    };
+    const std::vector<SystemTime> &getSystemTimes() const { return systemTimes; }
+    void resetSystemTimes();
+
+private:
+    struct Task
+    {
+        const char *name;
+        SystemAccess access;
+        std::function<void()> run;
+        std::vector<std::size_t> dependents;
+        int dependencyCount = 0;
+        float milliseconds = 0.0f;
+    };
+
+    static void runTask(void *context, std::size_t taskIndex, std::size_t);
+    static void timeTask(Task &task);
+    void submit(std::size_t taskIndex);
+    void finishRun();
+
+    JobSystem &jobs;
+    std::vector<Task> tasks;
+    std::unique_ptr<std::atomic<int>[]> remaining; // unfinished dependencies per task
+    std::size_t remainingCapacity = 0;
+    JobCounter frame;
+    std::vector<SystemTime> systemTimes;
+};
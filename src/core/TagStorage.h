@@ -0,0 +1,213 @@
+#pragma once
+#include "ECSTypes.h"
+#include <vector>
+#include <array>
+#include <optional>
+#include <tuple>
+#include <cstdint>
+#include <algorithm>
+
+// Tag components (empty structs such as PlayerTag or MobTag) carry no data, so
+// the ECS keeps them out of the storage backend: each tag type is a dense
+// bitset keyed by entity index. Membership is one bit per entity, a tag test
+// is a single load, and iteration bit-scans whole 64-bit words. Whichever
+// backend is selected, views filter tags through entity signatures only.
+
+inline unsigned lowestSetBit(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+    unsigned bit = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+class TagSet {
+private:
+    std::vector<std::uint64_t> words;
+    std::size_t count = 0;
+
+public:
+    void set(std::uint32_t index) {
+        std::size_t word = index / 64;
+        if (word >= words.size()) {
+            words.resize(word + 1, 0);
+        }
+        std::uint64_t bit = std::uint64_t(1) << (index % 64);
+        if (!(words[word] & bit)) {
+            words[word] |= bit;
+            ++count;
+        }
+    }
+
+    void reset(std::uint32_t index) {
+        std::size_t word = index / 64;
+        std::uint64_t bit = std::uint64_t(1) << (index % 64);
+        if (word < words.size() && (words[word] & bit)) {
+            words[word] &= ~bit;
+            --count;
+        }
+    }
+
+    bool test(std::uint32_t index) const {
+        std::size_t word = index / 64;
+        return word < words.size() && (words[word] >> (index % 64)) & 1;
+    }
+
+    const std::vector<std::uint64_t>& bits() const { return words; }
+    std::size_t size() const { return count; }
+};
+
+class TagRangeBase {
+public:
+    virtual ~TagRangeBase() = default;
+};
+
+// Every entity carrying tag T, in index order. Iterates (EntityID, T&) pairs
+// like the component pools; the T& refers to a shared empty instance.
+template<typename T>
+class TagRange : public TagRangeBase {
+private:
+    const TagSet* tags;
+    const std::vector<std::uint32_t>* generations;
+
+public:
+    class iterator {
+    private:
+        const TagRange* range;
+        std::size_t word;
+        std::uint64_t bits;
+        std::optional<std::pair<EntityID, T&>> current;
+
+        void settle() {
+            const std::vector<std::uint64_t>& words = range->tags->bits();
+            while (!bits && ++word < words.size()) {
+                bits = words[word];
+            }
+            if (!bits) {
+                word = words.size();
+            }
+        }
+
+    public:
+        iterator(const TagRange* range, std::size_t word) : range(range), word(word), bits(0) {
+            const std::vector<std::uint64_t>& words = range->tags->bits();
+            if (word < words.size()) {
+                bits = words[word];
+                settle();
+            }
+        }
+
+        std::pair<EntityID, T&>& operator*() {
+            std::uint32_t index = static_cast<std::uint32_t>(word * 64 + lowestSetBit(bits));
+            current.emplace(makeEntityID(index, (*range->generations)[index]), tagInstance<T>());
+            return *current;
+        }
+
+        iterator& operator++() {
+            bits &= bits - 1;
+            settle();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return word == other.word && bits == other.bits; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+    };
+
+    TagRange(const TagSet* tags, const std::vector<std::uint32_t>* generations) : tags(tags), generations(generations) {}
+
+    std::size_t size() const { return tags->size(); }
+    bool empty() const { return tags->size() == 0; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, tags->bits().size()); }
+};
+
+// Join over tags only: ANDs the tag bitsets a word at a time and bit-scans
+// the result. Entities queued for removal are skipped like in other views.
+template<typename... Ts>
+class TagView {
+private:
+    std::array<const TagSet*, sizeof...(Ts)> sets;
+    const std::vector<std::uint32_t>* generations;
+    const std::vector<ComponentSignature>* signatures;
+    std::size_t wordCount;
+
+    std::uint64_t wordAt(std::size_t word) const {
+        std::uint64_t bits = ~std::uint64_t(0);
+        for (const TagSet* set : sets) {
+            bits &= set->bits()[word];
+        }
+        return bits;
+    }
+
+public:
+    class iterator {
+    private:
+        const TagView* view;
+        std::size_t word;
+        std::uint64_t bits;
+
+        std::uint32_t index() const { return static_cast<std::uint32_t>(word * 64 + lowestSetBit(bits)); }
+
+        void settle() {
+            while (true) {
+                while (!bits && ++word < view->wordCount) {
+                    bits = view->wordAt(word);
+                }
+                if (!bits) {
+                    word = view->wordCount;
+                    return;
+                }
+                if (!(*view->signatures)[index()].test(PENDING_REMOVAL_BIT)) {
+                    return;
+                }
+                bits &= bits - 1;
+            }
+        }
+
+    public:
+        iterator(const TagView* view, std::size_t word) : view(view), word(word), bits(0) {
+            if (word < view->wordCount) {
+                bits = view->wordAt(word);
+                settle();
+            }
+        }
+
+        std::tuple<EntityID, Ts&...> operator*() const {
+            std::uint32_t i = index();
+            return std::tuple<EntityID, Ts&...>(makeEntityID(i, (*view->generations)[i]), tagInstance<Ts>()...);
+        }
+
+        iterator& operator++() {
+            bits &= bits - 1;
+            settle();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const { return word == other.word && bits == other.bits; }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+    };
+
+    TagView(std::array<const TagSet*, sizeof...(Ts)> sets, const std::vector<std::uint32_t>& generations,
+            const std::vector<ComponentSignature>& signatures)
+        : sets(sets), generations(&generations), signatures(&signatures), wordCount(static_cast<std::size_t>(-1)) {
+        for (const TagSet* set : sets) {
+            wordCount = std::min(wordCount, set->bits().size());
+        }
+    }
+
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, wordCount); }
+
+    template<typename Fn>
+    void each(Fn&& fn) const {
+        for (auto it = begin(); it != end(); ++it) {
+            std::apply(fn, *it);
+        }
+    }
+};
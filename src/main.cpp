@@ -1,11 +1,107 @@
 #include "core/Game.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
+namespace
+{
+    void printUsage(const char *program)
+    {
+        std::cerr << "Usage: " << program << " [options]\n"
+                  << "  --headless         run without a window, renderer or audio\n"
+                  << "  --realtime         with --headless, pace ticks to the wall clock\n"
+                  << "  --tick-rate <hz>   simulation ticks per second\n"
+                  << "  --ticks <n>        quit after n simulation ticks\n"
+                  << "  --start <action>   menu action to run at start-up (singleplayer, dualplayer, host)\n"
+                  << "  --start-after <n>  wait at the menu for n frames before running the start action\n"
+                  << "  --seed <n>         deterministic run: seed every random stream from n\n"
+                  << "  --hash-log <file>  write each tick's state hash to file\n"
+                  << "  --record <file>    record each tick's input from the start of play\n"
+                  << "  --replay <file>    play a recording back (as fast as possible with --headless)\n"
+                  << "  --trace <file>     write a Chrome trace (chrome://tracing, Perfetto) of some frames\n"
+                  << "  --trace-frames <first>-<last>\n"
+                  << "                     frames to trace (default 0-299)\n"
+                  << "  --metrics-port <n> serve Prometheus metrics on localhost port n\n";
+    }
+}
+
 int main(int argc, char *argv[])
 {
+    GameOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            options.headless = true;
+        }
+        else if (std::strcmp(argv[i], "--realtime") == 0)
+        {
+            options.realtime = true;
+        }
+        else if (std::strcmp(argv[i], "--tick-rate") == 0 && hasValue)
+        {
+            options.tickRate = std::strtof(argv[++i], nullptr);
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue)
+        {
+            options.maxTicks = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--start") == 0 && hasValue)
+        {
+            options.startAction = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--start-after") == 0 && hasValue)
+        {
+            options.startAfterFrames = std::strtol(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            options.deterministic = true;
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--hash-log") == 0 && hasValue)
+        {
+            options.hashLogPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && hasValue)
+        {
+            options.recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && hasValue)
+        {
+            options.replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--trace") == 0 && hasValue)
+        {
+            options.tracePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--trace-frames") == 0 && hasValue)
+        {
+            long first, last;
+            if (std::sscanf(argv[++i], "%ld-%ld", &first, &last) != 2 || first < 0 || last < first)
+            {
+                printUsage(argv[0]);
+                return 1;
+            }
+            options.traceFirstFrame = first;
+            options.traceFrameCount = last - first + 1;
+        }
+        else if (std::strcmp(argv[i], "--metrics-port") == 0 && hasValue)
+        {
+            options.metricsPort = static_cast<int>(std::strtol(argv[++i], nullptr, 10));
+        }
+        else
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
     Game game;
 
-    if (!game.initialize())
+    if (!game.initialize(options))
     {
         std::cerr << "Failed to initialize game!" << std::endl;
         return 1;
@@ -1,9 +1,19 @@
 #include "EntityFactory.h"
 #include "ResourceManager.h"
 #include "../components/Components.h"
+#include "../core/Random.h"
 #include <fstream>
 #include <iostream>
-#include <random>
+
+EntityFactory::EntityFactory(ResourceManager *rm)
+    : resourceManager(rm), randomGenerator(streamSeed(randomMasterSeed(), "entityFactory"))
+{
+}
+
+void EntityFactory::setRandomSeed(std::uint64_t masterSeed)
+{
+    randomGenerator.seed(streamSeed(masterSeed, "entityFactory"));
+}
 
 bool EntityFactory::loadConfig(const std::string &configFile)
 {
@@ -52,7 +62,7 @@ EntityID EntityFactory::createPlayer(ECS &ecs)
     ecs.addComponent(playerID, sprite);
 
     // Add Collider component
-    Collider collider = createColliderFromJSON(playerConfig["collider"]);
+    Collider collider = createColliderFromJSON(playerConfig["collider"], CollisionLayer::PLAYER);
     ecs.addComponent(playerID, collider);
 
     // Add Speed component
@@ -101,6 +111,7 @@ EntityID EntityFactory::createPlayer(ECS &ecs)
             weapon.ammoCount = weaponConfig["ammoCount"].get<int>();
             weapon.maxAmmo = weaponConfig["maxAmmo"].get<int>();
             weapon.range = weaponConfig["range"].get<float>();
+            weapon.hitscan = weaponConfig.contains("hitscan") && weaponConfig["hitscan"].get<bool>();
             weapon.fireTimer = 0.0f; // Ready to fire
             weapon.canFire = true;   // Ready to fire
             ecs.addComponent(playerID, weapon);
@@ -136,18 +147,16 @@ EntityID EntityFactory::createMob(ECS &ecs, const std::string &mobType)
     ecs.addComponent(mobID, sprite);
 
     // Add Collider component
-    Collider collider = createColliderFromJSON(mobConfig["collider"]);
+    Collider collider = createColliderFromJSON(mobConfig["collider"], CollisionLayer::MOB);
     ecs.addComponent(mobID, collider);
 
     // Add Speed component (random within range)
     float minSpeed = mobConfig["speedRange"]["min"].get<float>();
     float maxSpeed = mobConfig["speedRange"]["max"].get<float>();
 
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
     std::uniform_real_distribution<float> speedDist(minSpeed, maxSpeed);
 
-    Speed speed(speedDist(gen));
+    Speed speed(speedDist(randomGenerator));
     ecs.addComponent(mobID, speed);
 
     // Add Animation component
@@ -212,8 +221,9 @@ Transform EntityFactory::createTransformFromJSON(const json &config, const json
 
 Sprite EntityFactory::createSpriteFromJSON(const json &config)
 {
+    // Without a resource manager (headless) sprites keep their size but no texture
     std::string texturePath = config["texture"].get<std::string>();
-    SDL_Texture *texture = resourceManager->loadTexture(texturePath);
+    SDL_Texture *texture = resourceManager ? resourceManager->loadTexture(texturePath) : nullptr;
 
     int width = config["width"].get<int>();
     int height = config["height"].get<int>();
@@ -223,13 +233,13 @@ Sprite EntityFactory::createSpriteFromJSON(const json &config)
     return Sprite(texture, width, height, frameCount, frameTime);
 }
 
-Collider EntityFactory::createColliderFromJSON(const json &config)
+Collider EntityFactory::createColliderFromJSON(const json &config, std::uint32_t layer)
 {
     float width = config["width"].get<float>();
     float height = config["height"].get<float>();
     bool isTrigger = config.contains("isTrigger") ? config["isTrigger"].get<bool>() : false;
 
-    return Collider(width, height, isTrigger);
+    return Collider(width, height, isTrigger, layer);
 }
 
 Speed EntityFactory::createSpeedFromJSON(const json &config)
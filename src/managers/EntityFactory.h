@@ -2,6 +2,7 @@
 #include "../core/ECS.h"
 #include "../components/Components.h"
 #include <nlohmann/json.hpp>
+#include <random>
 #include <string>
 
 class ResourceManager; // Forward declaration
@@ -13,9 +14,13 @@ class EntityFactory
 private:
     json entityConfig;
     ResourceManager *resourceManager;
+    std::mt19937 randomGenerator;
 
 public:
-    EntityFactory(ResourceManager *rm) : resourceManager(rm) {}
+    EntityFactory(ResourceManager *rm);
+
+    // Restarts the stream the factory rolls per-entity values (mob speeds) from
+    void setRandomSeed(std::uint64_t masterSeed);
 
     // Load entity configuration from JSON file
     bool loadConfig(const std::string &configFile);
@@ -35,7 +40,7 @@ private:
     // Helper methods for creating components from JSON
     Transform createTransformFromJSON(const json &config, const json &positionOverride = json::object());
     Sprite createSpriteFromJSON(const json &config);
-    Collider createColliderFromJSON(const json &config);
+    Collider createColliderFromJSON(const json &config, std::uint32_t layer);
     Speed createSpeedFromJSON(const json &config);
     UIText createUITextFromJSON(const json &config);
     UIPosition createUIPositionFromJSON(const json &config);
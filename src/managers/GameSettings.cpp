@@ -220,6 +220,14 @@ bool GameSettings::loadSettings(const std::string &filePath)
             {
                 targetFPS = graphics["targetFPS"].get<int>();
             }
+            if (graphics.contains("frameLimiter"))
+            {
+                frameLimiter = graphics["frameLimiter"].get<std::string>();
+            }
+            if (graphics.contains("frameSpinMicroseconds"))
+            {
+                frameSpinMicroseconds = graphics["frameSpinMicroseconds"].get<int>();
+            }
             if (graphics.contains("backgroundColor"))
             {
                 backgroundColor = parseColor(graphics["backgroundColor"]);
@@ -345,6 +353,97 @@ bool GameSettings::loadSettings(const std::string &filePath)
             }
         }
 
+        // Load Simulation Settings
+        if (settings.contains("simulation"))
+        {
+            auto simulation = settings["simulation"];
+
+            if (simulation.contains("tickRate"))
+            {
+                simulationTickRate = simulation["tickRate"].get<float>();
+            }
+            if (simulation.contains("maxTicksPerFrame"))
+            {
+                maxTicksPerFrame = simulation["maxTicksPerFrame"].get<int>();
+            }
+            if (simulation.contains("deterministic"))
+            {
+                deterministic = simulation["deterministic"].get<bool>();
+            }
+            if (simulation.contains("seed"))
+            {
+                simulationSeed = simulation["seed"].get<std::uint64_t>();
+            }
+        }
+
+        // Load Collision Settings
+        if (settings.contains("collision"))
+        {
+            auto collision = settings["collision"];
+
+            if (collision.contains("broadphase"))
+            {
+                broadphaseType = collision["broadphase"].get<std::string>();
+            }
+        }
+
+        // Load Performance Settings
+        if (settings.contains("performance"))
+        {
+            auto performance = settings["performance"];
+
+            if (performance.contains("workerThreads"))
+            {
+                workerThreads = performance["workerThreads"].get<int>();
+            }
+        }
+
+        // Load Flight Recorder Settings
+        if (settings.contains("flightRecorder"))
+        {
+            auto flightRecorder = settings["flightRecorder"];
+
+            if (flightRecorder.contains("enabled"))
+            {
+                flightRecorderEnabled = flightRecorder["enabled"].get<bool>();
+            }
+            if (flightRecorder.contains("frames"))
+            {
+                flightRecorderFrames = flightRecorder["frames"].get<int>();
+            }
+            if (flightRecorder.contains("framesAfter"))
+            {
+                flightRecorderFramesAfter = flightRecorder["framesAfter"].get<int>();
+            }
+            if (flightRecorder.contains("budgetMs"))
+            {
+                flightRecorderBudgetMs = flightRecorder["budgetMs"].get<float>();
+            }
+            if (flightRecorder.contains("pathPrefix"))
+            {
+                flightRecorderPathPrefix = flightRecorder["pathPrefix"].get<std::string>();
+            }
+        }
+
+        // Load Metrics Settings
+        if (settings.contains("metrics"))
+        {
+            auto metrics = settings["metrics"];
+
+            if (metrics.contains("enabled"))
+            {
+                metricsEnabled = metrics["enabled"].get<bool>();
+            }
+            if (metrics.contains("port"))
+            {
+                metricsPort = metrics["port"].get<int>();
+            }
+            if (metrics.contains("publishIntervalMs"))
+            {
+                metricsPublishIntervalMs = metrics["publishIntervalMs"].get<int>();
+            }
+        }
+
         if (enableLogging)
         {
             std::cout << "GameSettings: Successfully loaded settings from " << filePath << std::endl;
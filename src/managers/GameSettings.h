@@ -1,4 +1,5 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <fstream>
@@ -69,6 +70,10 @@ public:
     float getScreenWidth() const { return screenWidth; }
     float getScreenHeight() const { return screenHeight; }
     int getTargetFPS() const { return targetFPS; }
+    // "fixed" holds the frame rate at targetFPS; "uncapped" renders as fast as it can
+    std::string getFrameLimiter() const { return frameLimiter; }
+    // Final stretch of each frame spun rather than slept, for an exact frame time
+    int getFrameSpinMicroseconds() const { return frameSpinMicroseconds; }
 
     struct Color
     {
@@ -108,6 +113,38 @@ public:
     bool shouldShowFPS() const { return showFPS; }
     bool shouldShowDebugInfo() const { return showDebugInfo; }
 
+    // Simulation Settings
+    // Fixed simulation ticks per second, independent of the render rate
+    float getSimulationTickRate() const { return simulationTickRate; }
+    // Most ticks one frame may run to catch up; longer stalls are dropped
+    int getMaxTicksPerFrame() const { return maxTicksPerFrame; }
+    // Seeds every random stream from `seed` so runs repeat exactly
+    bool isDeterministic() const { return deterministic; }
+    std::uint64_t getSimulationSeed() const { return simulationSeed; }
+
+    // Collision Settings
+    // Broadphase implementation: "grid", "sweepAndPrune" or "aabbTree"
+    std::string getBroadphaseType() const { return broadphaseType; }
+
+    // Performance Settings
+    // Worker threads for the job system; 0 picks one per spare core
+    int getWorkerThreads() const { return workerThreads; }
+
+    // Flight Recorder Settings
+    // Keeps the last `frames` frames; one over budgetMs writes them, plus
+    // framesAfter more, to <pathPrefix><frame>.csv
+    bool isFlightRecorderEnabled() const { return flightRecorderEnabled; }
+    int getFlightRecorderFrames() const { return flightRecorderFrames; }
+    int getFlightRecorderFramesAfter() const { return flightRecorderFramesAfter; }
+    float getFlightRecorderBudgetMs() const { return flightRecorderBudgetMs; }
+    std::string getFlightRecorderPathPrefix() const { return flightRecorderPathPrefix; }
+
+    // Metrics Settings
+    // Prometheus text over HTTP on localhost:port, refreshed every publishIntervalMs
+    bool isMetricsEnabled() const { return metricsEnabled; }
+    int getMetricsPort() const { return metricsPort; }
+    int getMetricsPublishIntervalMs() const { return metricsPublishIntervalMs; }
+
     // Setter methods for runtime modification
     void setMusicVolume(int volume) { musicVolume = volume; }
     void setSFXVolume(int volume) { sfxVolume = volume; }
@@ -172,6 +209,8 @@ private:
     float screenWidth = 1280.0f;
     float screenHeight = 720.0f;
     int targetFPS = 60;
+    std::string frameLimiter = "fixed";
+    int frameSpinMicroseconds = 2000;
     Color backgroundColor = {135, 206, 235, 255};
     Color aimingLineNormalColor = {255, 255, 255, 200};
     Color aimingLineShootingColor = {255, 0, 0, 200};
@@ -199,4 +238,28 @@ private:
     bool enableLogging = true;
     bool showFPS = true;
     bool showDebugInfo = false;
+
+    // Simulation Settings
+    float simulationTickRate = 60.0f;
+    int maxTicksPerFrame = 5;
+    bool deterministic = false;
+    std::uint64_t simulationSeed = 1;
+
+    // Collision Settings
+    std::string broadphaseType = "grid";
+
+    // Performance Settings
+    int workerThreads = 0;
+
+    // Flight Recorder Settings
+    bool flightRecorderEnabled = true;
+    int flightRecorderFrames = 300;
+    int flightRecorderFramesAfter = 60;
+    float flightRecorderBudgetMs = 50.0f;
+    std::string flightRecorderPathPrefix = "flight_";
+
+    // Metrics Settings
+    bool metricsEnabled = false;
+    int metricsPort = 9464;
+    int metricsPublishIntervalMs = 250;
 };
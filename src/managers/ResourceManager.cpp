@@ -17,6 +17,8 @@ SDL_Texture *ResourceManager::loadTexture(const std::string &path)
         return it->second;
     }
 
+    textureCacheMisses++;
+
     // Construct full path to asset
     std::string fullPath = std::string(ASSET_PATH) + path;
 
@@ -95,6 +97,7 @@ SDL_Texture *ResourceManager::createTextTexture(const std::string &text, TTF_Fon
     if (!font)
         return nullptr;
 
+    textureCacheMisses++;
     SDL_Surface *surface = TTF_RenderText_Solid(font, text.c_str(), color);
     if (!surface)
     {
@@ -10,6 +10,7 @@ private:
     SDL_Renderer* renderer;
     std::unordered_map<std::string, SDL_Texture*> textures;
     std::unordered_map<std::string, TTF_Font*> fonts;
+    unsigned textureCacheMisses = 0;
 
 public:
     ResourceManager(SDL_Renderer* renderer);
@@ -28,6 +29,10 @@ public:
     // Create text texture from font
     SDL_Texture* createTextTexture(const std::string& text, TTF_Font* font, SDL_Color color);
     
+    // Textures built since startup: loadTexture() misses plus every
+    // createTextTexture() call, which is never cached
+    unsigned getTextureCacheMisses() const { return textureCacheMisses; }
+
     // Cleanup
     void cleanup();
 
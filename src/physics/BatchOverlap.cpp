@@ -0,0 +1,165 @@
+#include "BatchOverlap.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define BATCH_OVERLAP_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define BATCH_OVERLAP_NEON
+#include <arm_neon.h>
+#endif
+
+// AVX2 is compiled per function so the rest of the build needs no -mavx2
+#if defined(BATCH_OVERLAP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define BATCH_OVERLAP_AVX2
+#endif
+
+namespace
+{
+    using OverlapKernel = void (*)(const AABB &, const float *, const float *, const float *, const float *,
+                                   std::size_t, std::uint64_t *);
+
+    void clearMask(std::size_t count, std::uint64_t *hitMask)
+    {
+        for (std::size_t word = 0; word < (count + 63) / 64; word++)
+        {
+            hitMask[word] = 0;
+        }
+    }
+
+    void overlapScalarRange(const AABB &query, const float *minX, const float *minY, const float *maxX, const float *maxY,
+                            std::size_t begin, std::size_t count, std::uint64_t *hitMask)
+    {
+        for (std::size_t i = begin; i < count; i++)
+        {
+            bool hit = minX[i] <= query.maxX && maxX[i] >= query.minX &&
+                       minY[i] <= query.maxY && maxY[i] >= query.minY;
+            hitMask[i / 64] |= std::uint64_t(hit) << (i % 64);
+        }
+    }
+
+#if !defined(BATCH_OVERLAP_X86) && !defined(BATCH_OVERLAP_NEON)
+    void overlapScalar(const AABB &query, const float *minX, const float *minY, const float *maxX, const float *maxY,
+                       std::size_t count, std::uint64_t *hitMask)
+    {
+        clearMask(count, hitMask);
+        overlapScalarRange(query, minX, minY, maxX, maxY, 0, count, hitMask);
+    }
+#endif
+
+#ifdef BATCH_OVERLAP_X86
+    void overlapSSE2(const AABB &query, const float *minX, const float *minY, const float *maxX, const float *maxY,
+                     std::size_t count, std::uint64_t *hitMask)
+    {
+        clearMask(count, hitMask);
+        __m128 queryMinX = _mm_set1_ps(query.minX);
+        __m128 queryMinY = _mm_set1_ps(query.minY);
+        __m128 queryMaxX = _mm_set1_ps(query.maxX);
+        __m128 queryMaxY = _mm_set1_ps(query.maxY);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128 x = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minX + i), queryMaxX),
+                                  _mm_cmpge_ps(_mm_loadu_ps(maxX + i), queryMinX));
+            __m128 y = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(minY + i), queryMaxY),
+                                  _mm_cmpge_ps(_mm_loadu_ps(maxY + i), queryMinY));
+            std::uint64_t bits = static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(x, y)));
+            hitMask[i / 64] |= bits << (i % 64);
+        }
+        overlapScalarRange(query, minX, minY, maxX, maxY, i, count, hitMask);
+    }
+#endif
+
+#ifdef BATCH_OVERLAP_AVX2
+    __attribute__((target("avx2"))) void overlapAVX2(const AABB &query, const float *minX, const float *minY,
+                                                     const float *maxX, const float *maxY,
+                                                     std::size_t count, std::uint64_t *hitMask)
+    {
+        clearMask(count, hitMask);
+        __m256 queryMinX = _mm256_set1_ps(query.minX);
+        __m256 queryMinY = _mm256_set1_ps(query.minY);
+        __m256 queryMaxX = _mm256_set1_ps(query.maxX);
+        __m256 queryMaxY = _mm256_set1_ps(query.maxY);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256 x = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minX + i), queryMaxX, _CMP_LE_OQ),
+                                     _mm256_cmp_ps(_mm256_loadu_ps(maxX + i), queryMinX, _CMP_GE_OQ));
+            __m256 y = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minY + i), queryMaxY, _CMP_LE_OQ),
+                                     _mm256_cmp_ps(_mm256_loadu_ps(maxY + i), queryMinY, _CMP_GE_OQ));
+            std::uint64_t bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_and_ps(x, y)));
+            hitMask[i / 64] |= bits << (i % 64);
+        }
+        overlapScalarRange(query, minX, minY, maxX, maxY, i, count, hitMask);
+    }
+#endif
+
+#ifdef BATCH_OVERLAP_NEON
+    void overlapNEON(const AABB &query, const float *minX, const float *minY, const float *maxX, const float *maxY,
+                     std::size_t count, std::uint64_t *hitMask)
+    {
+        clearMask(count, hitMask);
+        float32x4_t queryMinX = vdupq_n_f32(query.minX);
+        float32x4_t queryMinY = vdupq_n_f32(query.minY);
+        float32x4_t queryMaxX = vdupq_n_f32(query.maxX);
+        float32x4_t queryMaxY = vdupq_n_f32(query.maxY);
+
+        // NEON has no movemask: weight each all-ones lane by its bit and sum
+        static const std::uint32_t laneBits[4] = {1, 2, 4, 8};
+        uint32x4_t weights = vld1q_u32(laneBits);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t x = vandq_u32(vcleq_f32(vld1q_f32(minX + i), queryMaxX),
+                                     vcgeq_f32(vld1q_f32(maxX + i), queryMinX));
+            uint32x4_t y = vandq_u32(vcleq_f32(vld1q_f32(minY + i), queryMaxY),
+                                     vcgeq_f32(vld1q_f32(maxY + i), queryMinY));
+            std::uint64_t bits = vaddvq_u32(vandq_u32(vandq_u32(x, y), weights));
+            hitMask[i / 64] |= bits << (i % 64);
+        }
+        overlapScalarRange(query, minX, minY, maxX, maxY, i, count, hitMask);
+    }
+#endif
+
+    struct KernelChoice
+    {
+        OverlapKernel kernel;
+        const char *name;
+    };
+
+    KernelChoice chooseKernel()
+    {
+#ifdef BATCH_OVERLAP_AVX2
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return {overlapAVX2, "avx2"};
+        }
+#endif
+#ifdef BATCH_OVERLAP_X86
+        return {overlapSSE2, "sse2"};
+#elif defined(BATCH_OVERLAP_NEON)
+        return {overlapNEON, "neon"};
+#else
+        return {overlapScalar, "scalar"};
+#endif
+    }
+
+    const KernelChoice &selectedKernel()
+    {
+        static const KernelChoice choice = chooseKernel();
+        return choice;
+    }
+}
+
+void batchOverlap(const AABB &query, const float *minX, const float *minY, const float *maxX, const float *maxY,
+                  std::size_t count, std::uint64_t *hitMask)
+{
+    selectedKernel().kernel(query, minX, minY, maxX, maxY, count, hitMask);
+}
+
+const char *batchOverlapKernelName()
+{
+    return selectedKernel().name;
+}
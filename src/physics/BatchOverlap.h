@@ -0,0 +1,33 @@
+#pragma once
+#include "Broadphase.h"
+#include <cstddef>
+#include <cstdint>
+
+// Batched narrowphase: tests one query box against `count` candidate boxes
+// stored structure-of-arrays (min/max x/y as separate float arrays) and sets
+// bit i of `hitMask` when box i overlaps (inclusive, like AABB::overlaps).
+// hitMask needs (count + 63) / 64 words; they are overwritten.
+//
+// The kernel is picked once at runtime from the CPU: AVX2 (8 boxes per step)
+// or SSE2 (4) on x86-64, NEON (4) on ARM64, otherwise scalar.
+void batchOverlap(const AABB &query, const float *minX, const float *minY, const float *maxX, const float *maxY,
+                  std::size_t count, std::uint64_t *hitMask);
+
+// "avx2", "sse2", "neon" or "scalar"
+const char *batchOverlapKernelName();
+
+// Index of the lowest set bit of a non-zero hit-mask word; walk the hits
+// with `for (; hits != 0; hits &= hits - 1)`
+inline unsigned lowestHit(std::uint64_t hits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(hits));
+#else
+    unsigned bit = 0;
+    while (!(hits >> bit & 1))
+    {
+        bit++;
+    }
+    return bit;
+#endif
+}
@@ -0,0 +1,24 @@
+#include "Broadphase.h"
+#include "SpatialHashGrid.h"
+#include "SweepAndPrune.h"
+#include "DynamicAABBTree.h"
+#include <iostream>
+
+std::unique_ptr<Broadphase> createBroadphase(const std::string &type, float typicalSize)
+{
+    if (type == "sweepAndPrune")
+    {
+        return std::make_unique<SweepAndPrune>();
+    }
+    if (type == "aabbTree")
+    {
+        // A quarter of a typical collider lets mobs move several frames
+        // before their leaf has to be reinserted
+        return std::make_unique<DynamicAABBTree>(typicalSize * 0.25f);
+    }
+    if (type != "grid")
+    {
+        std::cerr << "Warning: Unknown broadphase '" << type << "', using grid" << std::endl;
+    }
+    return std::make_unique<SpatialHashGrid>(typicalSize);
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "../core/ECSTypes.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+// Axis-aligned box in world space (min = top-left)
+struct AABB
+{
+    float minX, minY, maxX, maxY;
+
+    bool overlaps(const AABB &other) const
+    {
+        return minX <= other.maxX && maxX >= other.minX &&
+               minY <= other.maxY && maxY >= other.minY;
+    }
+
+    bool contains(const AABB &other) const
+    {
+        return minX <= other.minX && minY <= other.minY &&
+               maxX >= other.maxX && maxY >= other.maxY;
+    }
+};
+
+// A ray from (originX, originY) along the unit vector (dirX, dirY), ending
+// maxDistance away
+struct Ray
+{
+    float originX, originY;
+    float dirX, dirY;
+    float maxDistance;
+};
+
+// Nearest box a ray reached and how far along the ray it was entered
+// (0 when the ray starts inside it)
+struct RaycastHit
+{
+    EntityID entity = NULL_ENTITY;
+    float distance = 0.0f;
+};
+
+// Spatial index of collider boxes used to find candidate pairs. Refreshed
+// once per frame: beginFrame(), update() for every box, endFrame(). Entities
+// that weren't updated since beginFrame() are dropped by endFrame(), so
+// implementations can keep state between frames and only patch what moved.
+// Every box carries collision layer bits; a query passes a mask and only
+// sees boxes on one of its layers, so unwanted pairs never reach the caller.
+class Broadphase
+{
+public:
+    virtual ~Broadphase() = default;
+
+    virtual void beginFrame() = 0;
+    virtual void update(EntityID entity, const AABB &bounds, std::uint32_t layers) = 0;
+    virtual void endFrame() = 0;
+
+    virtual std::size_t size() const = 0;
+    virtual const char *getName() const = 0;
+
+    // Calls fn(EntityID) once for every box overlapping `bounds` whose layers
+    // intersect `mask`. Const, so parallel jobs may query at the same time.
+    template <typename Fn>
+    void query(const AABB &bounds, std::uint32_t mask, Fn &&fn) const
+    {
+        using Callback = std::remove_reference_t<Fn>;
+        queryBoxes(bounds, mask, [](void *context, EntityID entity)
+                   { (*static_cast<Callback *>(context))(entity); },
+                   const_cast<void *>(static_cast<const void *>(&fn)));
+    }
+
+    // Finds the nearest box along `ray` whose layers intersect `mask` and
+    // that accept(EntityID) doesn't reject; accept is only asked about boxes
+    // nearer than the best so far. Returns false if the ray reaches none.
+    template <typename Fn>
+    bool raycast(const Ray &ray, std::uint32_t mask, RaycastHit &hit, Fn &&accept) const
+    {
+        using Filter = std::remove_reference_t<Fn>;
+        return raycastBoxes(ray, mask, hit, [](void *context, EntityID entity)
+                            { return (*static_cast<Filter *>(context))(entity); },
+                            const_cast<void *>(static_cast<const void *>(&accept)));
+    }
+
+protected:
+    using QueryCallback = void (*)(void *context, EntityID entity);
+    virtual void queryBoxes(const AABB &bounds, std::uint32_t mask, QueryCallback callback, void *context) const = 0;
+
+    using RayFilter = bool (*)(void *context, EntityID entity);
+    virtual bool raycastBoxes(const Ray &ray, std::uint32_t mask, RaycastHit &hit, RayFilter accept, void *context) const = 0;
+};
+
+// type is "grid", "sweepAndPrune" or "aabbTree" (unknown types fall back to
+// the grid). typicalSize is a representative collider dimension: the grid's
+// cell size and the basis of the tree's box margin.
+std::unique_ptr<Broadphase> createBroadphase(const std::string &type, float typicalSize);
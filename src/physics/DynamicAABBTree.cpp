@@ -0,0 +1,417 @@
+#include "DynamicAABBTree.h"
+#include "SweptAABB.h"
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+    AABB combine(const AABB &a, const AABB &b)
+    {
+        return AABB{std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+                    std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+    }
+
+    // Perimeter is the 2D stand-in for surface area in the insertion cost
+    float perimeter(const AABB &box)
+    {
+        return 2.0f * ((box.maxX - box.minX) + (box.maxY - box.minY));
+    }
+}
+
+DynamicAABBTree::DynamicAABBTree(float margin)
+    : margin(margin > 0.0f ? margin : 0.0f)
+{
+}
+
+AABB DynamicAABBTree::fatten(const AABB &bounds) const
+{
+    return AABB{bounds.minX - margin, bounds.minY - margin, bounds.maxX + margin, bounds.maxY + margin};
+}
+
+std::int32_t DynamicAABBTree::allocateNode()
+{
+    if (freeList == NULL_NODE)
+    {
+        nodes.emplace_back();
+        return static_cast<std::int32_t>(nodes.size() - 1);
+    }
+    std::int32_t node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node] = Node();
+    return node;
+}
+
+void DynamicAABBTree::freeNode(std::int32_t node)
+{
+    nodes[node].parent = freeList;
+    nodes[node].height = -1;
+    freeList = node;
+}
+
+void DynamicAABBTree::beginFrame()
+{
+    frame++;
+}
+
+void DynamicAABBTree::update(EntityID entity, const AABB &bounds, std::uint32_t layers)
+{
+    std::uint32_t index = entityIndex(entity);
+    if (index >= leafOfIndex.size())
+    {
+        leafOfIndex.resize(index + 1, NULL_NODE);
+    }
+
+    // A leaf at this index belongs to this entity or to a dead earlier
+    // generation of it; either way it is reused
+    std::int32_t leaf = leafOfIndex[index];
+    if (leaf != NULL_NODE)
+    {
+        Node &node = nodes[leaf];
+        node.entity = entity;
+        node.tight = bounds;
+        node.layers = layers;
+        node.lastFrame = frame;
+        if (node.fat.contains(bounds))
+        {
+            return;
+        }
+        removeLeaf(leaf);
+        nodes[leaf].fat = fatten(bounds);
+        insertLeaf(leaf);
+        return;
+    }
+
+    leaf = allocateNode();
+    Node &node = nodes[leaf];
+    node.fat = fatten(bounds);
+    node.tight = bounds;
+    node.entity = entity;
+    node.layers = layers;
+    node.lastFrame = frame;
+    node.leafSlot = static_cast<std::uint32_t>(leaves.size());
+    leaves.push_back(leaf);
+    leafOfIndex[index] = leaf;
+    insertLeaf(leaf);
+}
+
+void DynamicAABBTree::endFrame()
+{
+    // Back to front so swap-removal never skips a leaf
+    for (std::size_t slot = leaves.size(); slot-- > 0;)
+    {
+        std::int32_t leaf = leaves[slot];
+        if (nodes[leaf].lastFrame == frame)
+        {
+            continue;
+        }
+
+        removeLeaf(leaf);
+        leafOfIndex[entityIndex(nodes[leaf].entity)] = NULL_NODE;
+        freeNode(leaf);
+
+        leaves[slot] = leaves.back();
+        nodes[leaves[slot]].leafSlot = static_cast<std::uint32_t>(slot);
+        leaves.pop_back();
+    }
+}
+
+void DynamicAABBTree::insertLeaf(std::int32_t leaf)
+{
+    if (root == NULL_NODE)
+    {
+        root = leaf;
+        nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling that grows the total perimeter least
+    AABB leafBox = nodes[leaf].fat;
+    std::int32_t index = root;
+    while (!nodes[index].isLeaf())
+    {
+        const Node &node = nodes[index];
+        float area = perimeter(node.fat);
+        float combinedArea = perimeter(combine(node.fat, leafBox));
+
+        // Cost of pairing with this node here, and the cost pushed onto
+        // every ancestor by descending further
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](std::int32_t child)
+        {
+            const Node &childNode = nodes[child];
+            float enlarged = perimeter(combine(childNode.fat, leafBox));
+            if (childNode.isLeaf())
+            {
+                return enlarged + inheritanceCost;
+            }
+            return enlarged - perimeter(childNode.fat) + inheritanceCost;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+        {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    std::int32_t sibling = index;
+    std::int32_t oldParent = nodes[sibling].parent;
+    std::int32_t newParent = allocateNode(); // may grow `nodes`; no references held
+
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].fat = combine(leafBox, nodes[sibling].fat);
+    nodes[newParent].height = nodes[sibling].height + 1;
+    nodes[newParent].child1 = sibling;
+    nodes[newParent].child2 = leaf;
+    nodes[sibling].parent = newParent;
+    nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE)
+    {
+        root = newParent;
+    }
+    else if (nodes[oldParent].child1 == sibling)
+    {
+        nodes[oldParent].child1 = newParent;
+    }
+    else
+    {
+        nodes[oldParent].child2 = newParent;
+    }
+
+    refitAncestors(nodes[leaf].parent);
+}
+
+void DynamicAABBTree::removeLeaf(std::int32_t leaf)
+{
+    if (leaf == root)
+    {
+        root = NULL_NODE;
+        return;
+    }
+
+    std::int32_t parent = nodes[leaf].parent;
+    std::int32_t grandParent = nodes[parent].parent;
+    std::int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    // The sibling takes the parent's place
+    freeNode(parent);
+    if (grandParent == NULL_NODE)
+    {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        return;
+    }
+
+    if (nodes[grandParent].child1 == parent)
+    {
+        nodes[grandParent].child1 = sibling;
+    }
+    else
+    {
+        nodes[grandParent].child2 = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+    refitAncestors(grandParent);
+}
+
+void DynamicAABBTree::refitAncestors(std::int32_t index)
+{
+    while (index != NULL_NODE)
+    {
+        index = balance(index);
+
+        Node &node = nodes[index];
+        node.height = 1 + std::max(nodes[node.child1].height, nodes[node.child2].height);
+        node.fat = combine(nodes[node.child1].fat, nodes[node.child2].fat);
+        index = node.parent;
+    }
+}
+
+// Rotates the taller grandchild up when a's subtrees differ in height by more
+// than one; returns the node now at a's position
+std::int32_t DynamicAABBTree::balance(std::int32_t iA)
+{
+    Node &a = nodes[iA];
+    if (a.isLeaf() || a.height < 2)
+    {
+        return iA;
+    }
+
+    std::int32_t iB = a.child1;
+    std::int32_t iC = a.child2;
+    Node &b = nodes[iB];
+    Node &c = nodes[iC];
+    int difference = c.height - b.height;
+
+    // Either way, the raised child replaces a under a's parent
+    auto replaceInParent = [&](std::int32_t raised)
+    {
+        Node &raisedNode = nodes[raised];
+        raisedNode.parent = a.parent;
+        a.parent = raised;
+        if (raisedNode.parent == NULL_NODE)
+        {
+            root = raised;
+        }
+        else if (nodes[raisedNode.parent].child1 == iA)
+        {
+            nodes[raisedNode.parent].child1 = raised;
+        }
+        else
+        {
+            nodes[raisedNode.parent].child2 = raised;
+        }
+    };
+
+    if (difference > 1)
+    {
+        // Raise c
+        std::int32_t iF = c.child1;
+        std::int32_t iG = c.child2;
+        Node &f = nodes[iF];
+        Node &g = nodes[iG];
+
+        c.child1 = iA;
+        replaceInParent(iC);
+
+        if (f.height > g.height)
+        {
+            c.child2 = iF;
+            a.child2 = iG;
+            g.parent = iA;
+            a.fat = combine(b.fat, g.fat);
+            c.fat = combine(a.fat, f.fat);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        }
+        else
+        {
+            c.child2 = iG;
+            a.child2 = iF;
+            f.parent = iA;
+            a.fat = combine(b.fat, f.fat);
+            c.fat = combine(a.fat, g.fat);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return iC;
+    }
+
+    if (difference < -1)
+    {
+        // Raise b
+        std::int32_t iD = b.child1;
+        std::int32_t iE = b.child2;
+        Node &d = nodes[iD];
+        Node &e = nodes[iE];
+
+        b.child1 = iA;
+        replaceInParent(iB);
+
+        if (d.height > e.height)
+        {
+            b.child2 = iD;
+            a.child1 = iE;
+            e.parent = iA;
+            a.fat = combine(c.fat, e.fat);
+            b.fat = combine(a.fat, d.fat);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        }
+        else
+        {
+            b.child2 = iE;
+            a.child1 = iD;
+            d.parent = iA;
+            a.fat = combine(c.fat, d.fat);
+            b.fat = combine(a.fat, e.fat);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return iB;
+    }
+
+    return iA;
+}
+
+void DynamicAABBTree::queryBoxes(const AABB &bounds, std::uint32_t mask, QueryCallback callback, void *context) const
+{
+    if (root == NULL_NODE)
+    {
+        return;
+    }
+
+    // The balanced tree stays shallow, so a fixed stack keeps queries
+    // allocation-free and safe to run from several threads
+    std::int32_t stack[MAX_QUERY_DEPTH];
+    int top = 0;
+    stack[top++] = root;
+    while (top > 0)
+    {
+        const Node &node = nodes[stack[--top]];
+        if (!node.fat.overlaps(bounds))
+        {
+            continue;
+        }
+
+        if (node.isLeaf())
+        {
+            if ((node.layers & mask) != 0 && node.tight.overlaps(bounds))
+            {
+                callback(context, node.entity);
+            }
+        }
+        else
+        {
+            assert(top + 2 <= MAX_QUERY_DEPTH && "AABB tree deeper than the query stack");
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+}
+
+bool DynamicAABBTree::raycastBoxes(const Ray &ray, std::uint32_t mask, RaycastHit &hit, RayFilter accept, void *context) const
+{
+    if (root == NULL_NODE)
+    {
+        return false;
+    }
+
+    // Subtrees the ray enters no nearer than the best hit so far are skipped
+    bool found = false;
+    std::int32_t stack[MAX_QUERY_DEPTH];
+    int top = 0;
+    stack[top++] = root;
+    while (top > 0)
+    {
+        const Node &node = nodes[stack[--top]];
+        float distance;
+        if (!raycastAABB(ray, node.fat, distance) || (found && distance >= hit.distance))
+        {
+            continue;
+        }
+
+        if (node.isLeaf())
+        {
+            if ((node.layers & mask) != 0 && raycastAABB(ray, node.tight, distance) &&
+                (!found || distance < hit.distance) && accept(context, node.entity))
+            {
+                hit.entity = node.entity;
+                hit.distance = distance;
+                found = true;
+            }
+        }
+        else
+        {
+            assert(top + 2 <= MAX_QUERY_DEPTH && "AABB tree deeper than the query stack");
+            stack[top++] = node.child1;
+            stack[top++] = node.child2;
+        }
+    }
+    return found;
+}
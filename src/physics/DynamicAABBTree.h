@@ -0,0 +1,63 @@
+#pragma once
+#include "Broadphase.h"
+#include <cstdint>
+#include <vector>
+
+// Bounding volume hierarchy with one leaf per box. Leaves store a fattened
+// copy of their box, so a box that moves a little stays inside it and the
+// tree is untouched; only boxes that leave their fat box are reinserted.
+// Insertion picks the sibling with the least added perimeter and AVL-style
+// rotations keep the tree balanced. Handles mixed sizes (bullets to the Mob
+// King) and uneven density well.
+class DynamicAABBTree : public Broadphase
+{
+public:
+    explicit DynamicAABBTree(float margin);
+
+    void beginFrame() override;
+    void update(EntityID entity, const AABB &bounds, std::uint32_t layers) override;
+    void endFrame() override;
+
+    std::size_t size() const override { return leaves.size(); }
+    const char *getName() const override { return "aabbTree"; }
+
+protected:
+    void queryBoxes(const AABB &bounds, std::uint32_t mask, QueryCallback callback, void *context) const override;
+    bool raycastBoxes(const Ray &ray, std::uint32_t mask, RaycastHit &hit, RayFilter accept, void *context) const override;
+
+private:
+    static constexpr std::int32_t NULL_NODE = -1;
+    static constexpr int MAX_QUERY_DEPTH = 256;
+
+    struct Node
+    {
+        AABB fat;   // leaf: box plus margin; internal: union of the children
+        AABB tight; // leaf: the box as last updated
+        std::int32_t parent = NULL_NODE; // next free node while on the free list
+        std::int32_t child1 = NULL_NODE;
+        std::int32_t child2 = NULL_NODE;
+        std::int32_t height = 0; // leaves are 0
+        EntityID entity = NULL_ENTITY;
+        std::uint32_t layers = 0; // leaves only
+        std::uint32_t lastFrame = 0;
+        std::uint32_t leafSlot = 0; // position in `leaves`
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    std::int32_t allocateNode();
+    void freeNode(std::int32_t node);
+    void insertLeaf(std::int32_t leaf);
+    void removeLeaf(std::int32_t leaf);
+    void refitAncestors(std::int32_t node);
+    std::int32_t balance(std::int32_t node);
+    AABB fatten(const AABB &bounds) const;
+
+    std::vector<Node> nodes;
+    std::int32_t root = NULL_NODE;
+    std::int32_t freeList = NULL_NODE;
+    std::vector<std::int32_t> leaves;      // every leaf node, for stale removal
+    std::vector<std::int32_t> leafOfIndex; // entity index -> leaf, or NULL_NODE
+    float margin;
+    std::uint32_t frame = 0;
+};
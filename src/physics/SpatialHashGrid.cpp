@@ -0,0 +1,215 @@
+#include "SpatialHashGrid.h"
+#include "SweptAABB.h"
+#include <cmath>
+#include <limits>
+
+namespace
+{
+    // Keeps cell coordinates well inside int range for far-away positions
+    constexpr float MAX_CELL_COORD = 1 << 30;
+}
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+{
+    setCellSize(cellSize);
+    clear();
+}
+
+void SpatialHashGrid::setCellSize(float size)
+{
+    cellSize = size > 1.0f ? size : 1.0f;
+    inverseCellSize = 1.0f / cellSize;
+}
+
+int SpatialHashGrid::cellCoord(float value) const
+{
+    float cell = std::floor(value * inverseCellSize);
+    return static_cast<int>(std::max(-MAX_CELL_COORD, std::min(cell, MAX_CELL_COORD)));
+}
+
+std::size_t SpatialHashGrid::bucketOf(int cellX, int cellY) const
+{
+    std::uint32_t hash = static_cast<std::uint32_t>(cellX) * 73856093u ^ static_cast<std::uint32_t>(cellY) * 19349663u;
+    return hash & bucketMask;
+}
+
+void SpatialHashGrid::clear()
+{
+    items.clear();
+    entries.clear();
+    entryMinX.clear();
+    entryMinY.clear();
+    entryMaxX.clear();
+    entryMaxY.clear();
+    bucketStart.assign(2, 0);
+    bucketMask = 0;
+    occupiedMinX = occupiedMinY = 0;
+    occupiedMaxX = occupiedMaxY = -1;
+}
+
+void SpatialHashGrid::insert(EntityID entity, const AABB &bounds, std::uint32_t layers)
+{
+    Item item;
+    item.entity = entity;
+    item.bounds = bounds;
+    item.layers = layers;
+    item.minCellX = cellCoord(bounds.minX);
+    item.minCellY = cellCoord(bounds.minY);
+    item.maxCellX = cellCoord(bounds.maxX);
+    item.maxCellY = cellCoord(bounds.maxY);
+
+    if (items.empty())
+    {
+        occupiedMinX = item.minCellX;
+        occupiedMinY = item.minCellY;
+        occupiedMaxX = item.maxCellX;
+        occupiedMaxY = item.maxCellY;
+    }
+    else
+    {
+        occupiedMinX = std::min(occupiedMinX, item.minCellX);
+        occupiedMinY = std::min(occupiedMinY, item.minCellY);
+        occupiedMaxX = std::max(occupiedMaxX, item.maxCellX);
+        occupiedMaxY = std::max(occupiedMaxY, item.maxCellY);
+    }
+    items.push_back(item);
+}
+
+void SpatialHashGrid::build()
+{
+    std::size_t cellRefs = 0;
+    for (const Item &item : items)
+    {
+        cellRefs += static_cast<std::size_t>(item.maxCellX - item.minCellX + 1) *
+                    static_cast<std::size_t>(item.maxCellY - item.minCellY + 1);
+    }
+
+    // About two buckets per cell reference keeps chains short
+    std::size_t bucketCount = 16;
+    while (bucketCount < cellRefs * 2)
+    {
+        bucketCount *= 2;
+    }
+    bucketMask = bucketCount - 1;
+
+    // Count entries per bucket, prefix-sum into start offsets, then scatter
+    bucketStart.assign(bucketCount + 1, 0);
+    for (const Item &item : items)
+    {
+        for (int cellY = item.minCellY; cellY <= item.maxCellY; cellY++)
+        {
+            for (int cellX = item.minCellX; cellX <= item.maxCellX; cellX++)
+            {
+                bucketStart[bucketOf(cellX, cellY) + 1]++;
+            }
+        }
+    }
+    for (std::size_t b = 0; b < bucketCount; b++)
+    {
+        bucketStart[b + 1] += bucketStart[b];
+    }
+
+    entries.resize(cellRefs);
+    entryMinX.resize(cellRefs);
+    entryMinY.resize(cellRefs);
+    entryMaxX.resize(cellRefs);
+    entryMaxY.resize(cellRefs);
+    bucketFill.assign(bucketStart.begin(), bucketStart.end() - 1);
+    for (std::uint32_t i = 0; i < items.size(); i++)
+    {
+        const Item &item = items[i];
+        for (int cellY = item.minCellY; cellY <= item.maxCellY; cellY++)
+        {
+            for (int cellX = item.minCellX; cellX <= item.maxCellX; cellX++)
+            {
+                std::uint32_t e = bucketFill[bucketOf(cellX, cellY)]++;
+                entries[e] = {i, cellX, cellY};
+                entryMinX[e] = item.bounds.minX;
+                entryMinY[e] = item.bounds.minY;
+                entryMaxX[e] = item.bounds.maxX;
+                entryMaxY[e] = item.bounds.maxY;
+            }
+        }
+    }
+}
+
+void SpatialHashGrid::queryBoxes(const AABB &bounds, std::uint32_t mask, QueryCallback callback, void *context) const
+{
+    query(bounds, mask, [callback, context](EntityID entity)
+          { callback(context, entity); });
+}
+
+bool SpatialHashGrid::raycastBoxes(const Ray &ray, std::uint32_t mask, RaycastHit &hit, RayFilter accept, void *context) const
+{
+    if (items.empty())
+    {
+        return false;
+    }
+
+    // Distance along the ray to the next vertical and horizontal cell
+    // boundary, and how far apart successive boundaries are
+    const float infinity = std::numeric_limits<float>::infinity();
+    int cellX = cellCoord(ray.originX);
+    int cellY = cellCoord(ray.originY);
+    int stepX = ray.dirX > 0.0f ? 1 : (ray.dirX < 0.0f ? -1 : 0);
+    int stepY = ray.dirY > 0.0f ? 1 : (ray.dirY < 0.0f ? -1 : 0);
+    float nextX = stepX == 0 ? infinity : ((cellX + (stepX > 0)) * cellSize - ray.originX) / ray.dirX;
+    float nextY = stepY == 0 ? infinity : ((cellY + (stepY > 0)) * cellSize - ray.originY) / ray.dirY;
+    float spanX = stepX == 0 ? infinity : cellSize / std::fabs(ray.dirX);
+    float spanY = stepY == 0 ? infinity : cellSize / std::fabs(ray.dirY);
+
+    bool found = false;
+    while (true)
+    {
+        if (cellX >= occupiedMinX && cellX <= occupiedMaxX && cellY >= occupiedMinY && cellY <= occupiedMaxY)
+        {
+            std::size_t bucket = bucketOf(cellX, cellY);
+            for (std::uint32_t e = bucketStart[bucket]; e < bucketStart[bucket + 1]; e++)
+            {
+                const CellEntry &entry = entries[e];
+                const Item &item = items[entry.item];
+                if (entry.cellX != cellX || entry.cellY != cellY || (item.layers & mask) == 0)
+                {
+                    continue;
+                }
+
+                // A box spanning several cells may be tested more than once;
+                // it only counts when it beats the best hit
+                float distance;
+                if (raycastAABB(ray, item.bounds, distance) && (!found || distance < hit.distance) &&
+                    accept(context, item.entity))
+                {
+                    hit.entity = item.entity;
+                    hit.distance = distance;
+                    found = true;
+                }
+            }
+        }
+
+        // Boxes not tested yet are only entered beyond this cell, so a hit
+        // inside it is final
+        float cellExit = std::min(nextX, nextY);
+        if ((found && hit.distance <= cellExit) || cellExit >= ray.maxDistance)
+        {
+            return found;
+        }
+
+        // Past the occupied range and moving away from it: nothing left to hit
+        if ((stepX > 0 && cellX > occupiedMaxX) || (stepX < 0 && cellX < occupiedMinX) ||
+            (stepY > 0 && cellY > occupiedMaxY) || (stepY < 0 && cellY < occupiedMinY))
+        {
+            return found;
+        }
+
+        if (nextX < nextY)
+        {
+            cellX += stepX;
+            nextX += spanX;
+        }
+        else
+        {
+            cellY += stepY;
+            nextY += spanY;
+        }
+    }
+}
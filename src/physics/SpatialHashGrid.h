@@ -0,0 +1,121 @@
+#pragma once
+#include "Broadphase.h"
+#include "BatchOverlap.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// Uniform grid over world space, hashed so the world needs no fixed bounds.
+// Rebuilt each frame: clear(), insert() every collider, then build() sorts
+// the cell references into buckets (a counting sort, no per-cell allocation).
+// Boxes larger than a cell are referenced from every cell they cover.
+// Each bucket also keeps its boxes' bounds structure-of-arrays, so a crowded
+// cell is tested with one batchOverlap() call per 64 entries.
+// Rays walk the cells they cross in order (a DDA traversal) and stop at the
+// first cell that settles the nearest hit.
+// Suits dense, similarly sized populations.
+class SpatialHashGrid : public Broadphase
+{
+public:
+    explicit SpatialHashGrid(float cellSize = 64.0f);
+
+    void beginFrame() override { clear(); }
+    void update(EntityID entity, const AABB &bounds, std::uint32_t layers) override { insert(entity, bounds, layers); }
+    void endFrame() override { build(); }
+    const char *getName() const override { return "grid"; }
+
+    void setCellSize(float size);
+    float getCellSize() const { return cellSize; }
+
+    void clear();
+    void insert(EntityID entity, const AABB &bounds, std::uint32_t layers);
+    void build();
+
+    std::size_t size() const override { return items.size(); }
+
+    // Calls fn(EntityID) once for every inserted box overlapping `bounds` on a
+    // layer in `mask`; the non-virtual path when the concrete type is known
+    template <typename Fn>
+    void query(const AABB &bounds, std::uint32_t mask, Fn &&fn) const;
+
+protected:
+    void queryBoxes(const AABB &bounds, std::uint32_t mask, QueryCallback callback, void *context) const override;
+    bool raycastBoxes(const Ray &ray, std::uint32_t mask, RaycastHit &hit, RayFilter accept, void *context) const override;
+
+private:
+    struct Item
+    {
+        EntityID entity;
+        AABB bounds;
+        std::uint32_t layers;
+        int minCellX, minCellY, maxCellX, maxCellY;
+    };
+
+    // One (item, cell) pair; the cell is kept so hash collisions can be told apart
+    struct CellEntry
+    {
+        std::uint32_t item;
+        int cellX, cellY;
+    };
+
+    int cellCoord(float value) const;
+    std::size_t bucketOf(int cellX, int cellY) const;
+
+    float cellSize;
+    float inverseCellSize;
+
+    std::vector<Item> items;
+    std::vector<std::uint32_t> bucketStart; // bucket b's entries are [bucketStart[b], bucketStart[b + 1])
+    std::vector<CellEntry> entries;
+    std::vector<float> entryMinX, entryMinY, entryMaxX, entryMaxY; // parallel to entries
+    std::vector<std::uint32_t> bucketFill; // scratch for build()
+    std::size_t bucketMask = 0;
+    int occupiedMinX = 0, occupiedMinY = 0, occupiedMaxX = -1, occupiedMaxY = -1;
+};
+
+template <typename Fn>
+void SpatialHashGrid::query(const AABB &bounds, std::uint32_t mask, Fn &&fn) const
+{
+    if (items.empty())
+    {
+        return;
+    }
+
+    // Cells outside the occupied range can't hold anything
+    int firstX = std::max(cellCoord(bounds.minX), occupiedMinX);
+    int firstY = std::max(cellCoord(bounds.minY), occupiedMinY);
+    int lastX = std::min(cellCoord(bounds.maxX), occupiedMaxX);
+    int lastY = std::min(cellCoord(bounds.maxY), occupiedMaxY);
+
+    for (int cellY = firstY; cellY <= lastY; cellY++)
+    {
+        for (int cellX = firstX; cellX <= lastX; cellX++)
+        {
+            std::size_t bucket = bucketOf(cellX, cellY);
+            std::uint32_t bucketEnd = bucketStart[bucket + 1];
+            for (std::uint32_t block = bucketStart[bucket]; block < bucketEnd; block += 64)
+            {
+                std::uint64_t hits;
+                batchOverlap(bounds, &entryMinX[block], &entryMinY[block], &entryMaxX[block], &entryMaxY[block],
+                             std::min<std::uint32_t>(bucketEnd - block, 64), &hits);
+                for (; hits != 0; hits &= hits - 1)
+                {
+                    const CellEntry &entry = entries[block + lowestHit(hits)];
+                    if (entry.cellX != cellX || entry.cellY != cellY)
+                    {
+                        continue;
+                    }
+
+                    // A box spanning several queried cells is reported only from
+                    // the first cell the query and the box have in common
+                    const Item &item = items[entry.item];
+                    if ((item.layers & mask) != 0 &&
+                        cellX == std::max(item.minCellX, firstX) && cellY == std::max(item.minCellY, firstY))
+                    {
+                        fn(item.entity);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,184 @@
+#include "SweepAndPrune.h"
+#include "SweptAABB.h"
+#include <algorithm>
+
+void SweepAndPrune::beginFrame()
+{
+    frame++;
+}
+
+void SweepAndPrune::update(EntityID entity, const AABB &bounds, std::uint32_t layers)
+{
+    std::uint32_t index = entityIndex(entity);
+    if (index >= boxOfIndex.size())
+    {
+        boxOfIndex.resize(index + 1, NO_BOX);
+    }
+
+    // A box already at this index belongs to this entity or to a dead
+    // earlier generation of it; either way the slot is reused
+    std::uint32_t box = boxOfIndex[index];
+    if (box != NO_BOX)
+    {
+        boxes[box].entity = entity;
+        boxes[box].bounds = bounds;
+        boxes[box].layers = layers;
+        boxes[box].lastFrame = frame;
+        return;
+    }
+
+    box = static_cast<std::uint32_t>(boxes.size());
+    boxes.push_back({entity, bounds, layers, frame});
+    sorted.push_back({bounds.minX, box});
+    boxOfIndex[index] = box;
+    addedThisFrame++;
+}
+
+void SweepAndPrune::removeStaleBoxes()
+{
+    // Compact the live boxes, then drop stale endpoints; filtering keeps the
+    // endpoints in order
+    remap.assign(boxes.size(), NO_BOX);
+    std::uint32_t live = 0;
+    for (std::uint32_t box = 0; box < boxes.size(); box++)
+    {
+        if (boxes[box].lastFrame != frame)
+        {
+            boxOfIndex[entityIndex(boxes[box].entity)] = NO_BOX;
+            continue;
+        }
+        remap[box] = live;
+        boxes[live] = boxes[box];
+        boxOfIndex[entityIndex(boxes[live].entity)] = live;
+        live++;
+    }
+    boxes.resize(live);
+
+    std::size_t kept = 0;
+    for (const Endpoint &endpoint : sorted)
+    {
+        if (remap[endpoint.box] != NO_BOX)
+        {
+            sorted[kept++] = {endpoint.minX, remap[endpoint.box]};
+        }
+    }
+    sorted.resize(kept);
+}
+
+void SweepAndPrune::endFrame()
+{
+    bool anyStale = false;
+    maxWidth = 0.0f;
+    for (const Box &box : boxes)
+    {
+        anyStale |= box.lastFrame != frame;
+        maxWidth = std::max(maxWidth, box.bounds.maxX - box.bounds.minX);
+    }
+    if (anyStale)
+    {
+        removeStaleBoxes();
+    }
+
+    for (Endpoint &endpoint : sorted)
+    {
+        endpoint.minX = boxes[endpoint.box].bounds.minX;
+    }
+
+    auto byMinX = [](const Endpoint &a, const Endpoint &b)
+    { return a.minX < b.minX; };
+
+    // Many new boxes land far from their place; otherwise the order from last
+    // frame is nearly right and insertion sort only does the few swaps needed
+    if (addedThisFrame > sorted.size() / 4)
+    {
+        std::sort(sorted.begin(), sorted.end(), byMinX);
+    }
+    else
+    {
+        for (std::size_t i = 1; i < sorted.size(); i++)
+        {
+            Endpoint moving = sorted[i];
+            std::size_t j = i;
+            while (j > 0 && byMinX(moving, sorted[j - 1]))
+            {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+            sorted[j] = moving;
+        }
+    }
+    addedThisFrame = 0;
+
+    std::size_t count = sorted.size();
+    sortedMinX.resize(count);
+    sortedMinY.resize(count);
+    sortedMaxX.resize(count);
+    sortedMaxY.resize(count);
+    sortedLayers.resize(count);
+    sortedEntity.resize(count);
+    for (std::size_t i = 0; i < count; i++)
+    {
+        const Box &box = boxes[sorted[i].box];
+        sortedMinX[i] = box.bounds.minX;
+        sortedMinY[i] = box.bounds.minY;
+        sortedMaxX[i] = box.bounds.maxX;
+        sortedMaxY[i] = box.bounds.maxY;
+        sortedLayers[i] = box.layers;
+        sortedEntity[i] = box.entity;
+    }
+}
+
+void SweepAndPrune::queryBoxes(const AABB &bounds, std::uint32_t mask, QueryCallback callback, void *context) const
+{
+    // Only boxes starting inside [query.minX - widest box, query.maxX] can
+    // reach the query
+    std::size_t first = std::lower_bound(sortedMinX.begin(), sortedMinX.end(), bounds.minX - maxWidth) -
+                        sortedMinX.begin();
+    std::size_t last = std::upper_bound(sortedMinX.begin() + first, sortedMinX.end(), bounds.maxX) -
+                       sortedMinX.begin();
+
+    for (std::size_t block = first; block < last; block += 64)
+    {
+        std::uint64_t hits;
+        batchOverlap(bounds, &sortedMinX[block], &sortedMinY[block], &sortedMaxX[block], &sortedMaxY[block],
+                     std::min<std::size_t>(last - block, 64), &hits);
+        for (; hits != 0; hits &= hits - 1)
+        {
+            std::size_t i = block + lowestHit(hits);
+            if ((sortedLayers[i] & mask) != 0)
+            {
+                callback(context, sortedEntity[i]);
+            }
+        }
+    }
+}
+
+bool SweepAndPrune::raycastBoxes(const Ray &ray, std::uint32_t mask, RaycastHit &hit, RayFilter accept, void *context) const
+{
+    // The same x window as a query of the segment's bounds
+    float endX = ray.originX + ray.dirX * ray.maxDistance;
+    std::size_t first = std::lower_bound(sortedMinX.begin(), sortedMinX.end(),
+                                         std::min(ray.originX, endX) - maxWidth) - sortedMinX.begin();
+    std::size_t last = std::upper_bound(sortedMinX.begin() + first, sortedMinX.end(),
+                                        std::max(ray.originX, endX)) - sortedMinX.begin();
+
+    bool found = false;
+    for (std::size_t i = first; i < last; i++)
+    {
+        if ((sortedLayers[i] & mask) == 0)
+        {
+            continue;
+        }
+
+        float distance;
+        AABB box{sortedMinX[i], sortedMinY[i], sortedMaxX[i], sortedMaxY[i]};
+        if (raycastAABB(ray, box, distance) && (!found || distance < hit.distance) &&
+            accept(context, sortedEntity[i]))
+        {
+            hit.entity = sortedEntity[i];
+            hit.distance = distance;
+            found = true;
+        }
+    }
+    return found;
+}
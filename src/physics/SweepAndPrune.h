@@ -0,0 +1,60 @@
+#pragma once
+#include "Broadphase.h"
+#include "BatchOverlap.h"
+#include <cstdint>
+#include <vector>
+
+// Boxes kept sorted by their left edge across frames. Motion between frames
+// is small, so re-sorting is an insertion sort over an almost sorted array
+// (close to linear). A query binary-searches the x window that can reach it
+// (widened by the widest box) and tests only that slice, batched through
+// batchOverlap() on a structure-of-arrays copy of the sorted bounds. Cheap when the
+// population is sparse or spread out horizontally.
+class SweepAndPrune : public Broadphase
+{
+public:
+    void beginFrame() override;
+    void update(EntityID entity, const AABB &bounds, std::uint32_t layers) override;
+    void endFrame() override;
+
+    std::size_t size() const override { return boxes.size(); }
+    const char *getName() const override { return "sweepAndPrune"; }
+
+protected:
+    void queryBoxes(const AABB &bounds, std::uint32_t mask, QueryCallback callback, void *context) const override;
+    bool raycastBoxes(const Ray &ray, std::uint32_t mask, RaycastHit &hit, RayFilter accept, void *context) const override;
+
+private:
+    static constexpr std::uint32_t NO_BOX = 0xFFFFFFFFu;
+
+    struct Box
+    {
+        EntityID entity;
+        AABB bounds;
+        std::uint32_t layers;
+        std::uint32_t lastFrame;
+    };
+
+    // Sort key with its box, so the sweep reads one contiguous array
+    struct Endpoint
+    {
+        float minX;
+        std::uint32_t box;
+    };
+
+    void removeStaleBoxes();
+
+    std::vector<Box> boxes;
+    std::vector<Endpoint> sorted;           // by minX
+
+    // Bounds, layers and owners in sorted order, rebuilt by endFrame() for the query sweep
+    std::vector<float> sortedMinX, sortedMinY, sortedMaxX, sortedMaxY;
+    std::vector<std::uint32_t> sortedLayers;
+    std::vector<EntityID> sortedEntity;
+
+    std::vector<std::uint32_t> boxOfIndex;  // entity index -> box, or NO_BOX
+    std::vector<std::uint32_t> remap;       // scratch for removeStaleBoxes()
+    std::uint32_t frame = 0;
+    std::size_t addedThisFrame = 0;
+    float maxWidth = 0.0f;
+};
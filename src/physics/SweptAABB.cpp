@@ -0,0 +1,65 @@
+#include "SweptAABB.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    // Open interval of step times over which the two boxes overlap on one
+    // axis; false if they never do
+    bool axisOverlap(float movingMin, float movingMax, float delta, float targetMin, float targetMax,
+                     float &enter, float &exit)
+    {
+        if (delta == 0.0f)
+        {
+            enter = -std::numeric_limits<float>::infinity();
+            exit = std::numeric_limits<float>::infinity();
+            return movingMin < targetMax && movingMax > targetMin;
+        }
+
+        float first = (targetMin - movingMax) / delta;
+        float second = (targetMax - movingMin) / delta;
+        enter = std::min(first, second);
+        exit = std::max(first, second);
+        return true;
+    }
+}
+
+bool sweepAABB(const AABB &moving, float dx, float dy, const AABB &target, float &time)
+{
+    float enterX, exitX, enterY, exitY;
+    if (!axisOverlap(moving.minX, moving.maxX, dx, target.minX, target.maxX, enterX, exitX) ||
+        !axisOverlap(moving.minY, moving.maxY, dy, target.minY, target.maxY, enterY, exitY))
+    {
+        return false;
+    }
+
+    // Overlapping on both axes at once, within the step [0, 1)
+    float enter = std::max(enterX, enterY);
+    float exit = std::min(exitX, exitY);
+    if (enter >= exit || enter >= 1.0f || exit <= 0.0f)
+    {
+        return false;
+    }
+
+    time = std::max(enter, 0.0f);
+    return true;
+}
+
+AABB sweptBounds(const AABB &moving, float dx, float dy)
+{
+    return AABB{moving.minX + std::min(dx, 0.0f), moving.minY + std::min(dy, 0.0f),
+                moving.maxX + std::max(dx, 0.0f), moving.maxY + std::max(dy, 0.0f)};
+}
+
+bool raycastAABB(const Ray &ray, const AABB &target, float &distance)
+{
+    AABB point{ray.originX, ray.originY, ray.originX, ray.originY};
+    float time;
+    if (!sweepAABB(point, ray.dirX * ray.maxDistance, ray.dirY * ray.maxDistance, target, time))
+    {
+        return false;
+    }
+
+    distance = time * ray.maxDistance;
+    return true;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "Broadphase.h"
+
+// Continuous test for a box moving by (dx, dy) over one step against a box
+// that stays put. Returns true if they overlap (touching edges doesn't
+// count) at some point of the step, with `time` the first such moment as a
+// fraction of the step: 0 if they already overlap at the start.
+// Equivalent to a ray against the target grown by the mover's half extents,
+// so a fast, small box can't step over a target between frames.
+bool sweepAABB(const AABB &moving, float dx, float dy, const AABB &target, float &time);
+
+// Box covering `moving` over the whole step; what to query the broadphase with
+AABB sweptBounds(const AABB &moving, float dx, float dy);
+
+// Distance along `ray` at which it enters `target` (0 if it starts inside);
+// false if it misses it within ray.maxDistance. A sweep of a point box.
+bool raycastAABB(const Ray &ray, const AABB &target, float &distance);
@@ -10,6 +10,14 @@ AimingSystem::~AimingSystem()
 {
 }
 
+SystemAccess AimingSystem::getAccess() const
+{
+    return SystemAccess()
+        .read<PlayerTag, Transform>()
+        .write<MouseTarget, AimingLine>()
+        .read(SystemResource::Input);
+}
+
 void AimingSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 {
     updateMouseInput();
@@ -19,8 +27,10 @@ void AimingSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 
 void AimingSystem::updateMouseInput()
 {
-    Uint32 mouseState = SDL_GetMouseState(&mouseX, &mouseY);
-    mousePressed = (mouseState & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0;
+    InputFrame frame = input ? *input : InputFrame();
+    mouseX = frame.mouseX;
+    mouseY = frame.mouseY;
+    mousePressed = frame.isMouseButtonDown(SDL_BUTTON_LEFT);
 }
 
 void AimingSystem::updateMouseTarget(ECS &ecs, GameManager &gameManager)
@@ -2,12 +2,14 @@
 #include "System.h"
 #include "../core/ECS.h"
 #include "../managers/GameManager.h"
+#include "../core/InputFrame.h"
 #include <SDL2/SDL.h>
 #include <cmath>
 
 class AimingSystem : public System
 {
 private:
+    const InputFrame *input = nullptr;
     int mouseX, mouseY;
     bool mousePressed;
 
@@ -16,6 +18,10 @@ public:
     ~AimingSystem();
 
     void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
+    SystemAccess getAccess() const override;
+
+    // This tick's mouse state, captured or replayed by Game
+    void setInput(const InputFrame *frame) { input = frame; }
 
 private:
     void updateMouseInput();
@@ -1,6 +1,11 @@
 #include "AnimationSystem.h"
 #include "../components/Components.h"
 
+SystemAccess AnimationSystem::getAccess() const
+{
+    return SystemAccess().write<Animation, Sprite>();
+}
+
 void AnimationSystem::update(ECS &ecs, float deltaTime)
 {
     auto &animations = ecs.getComponents<Animation>();
@@ -5,4 +5,5 @@ class AnimationSystem : public System
 {
 public:
     void update(ECS &ecs, float deltaTime) override;
+    SystemAccess getAccess() const override;
 };
@@ -150,6 +150,11 @@ void AudioSystem::setSFXVolume(int volume)
     Mix_Volume(-1, sfxVolume);
 }
 
+SystemAccess AudioSystem::getAccess() const
+{
+    return SystemAccess().read(SystemResource::GameState).write(SystemResource::Audio);
+}
+
 void AudioSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 {
     static GameManager::GameState lastState = GameManager::MENU;
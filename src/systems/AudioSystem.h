@@ -42,6 +42,7 @@ public:
 
     // System update - handles game state music changes
     void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
+    SystemAccess getAccess() const override;
 
     // Cleanup
     void cleanup();
@@ -14,6 +14,7 @@ public:
         : screenWidth(screenW), screenHeight(screenH) {}
 
     void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
+    SystemAccess getAccess() const override;
 
 private:
     void keepPlayerInBounds(ECS &ecs);
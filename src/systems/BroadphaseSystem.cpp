@@ -0,0 +1,81 @@
+#include "BroadphaseSystem.h"
+#include "../components/Components.h"
+#include "../managers/GameSettings.h"
+#include "../physics/BatchOverlap.h"
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+BroadphaseSystem::BroadphaseSystem()
+    : broadphase(createBroadphase(GameSettings::getInstance().getBroadphaseType(), 64.0f))
+{
+}
+
+SystemAccess BroadphaseSystem::getAccess() const
+{
+    return SystemAccess()
+        .read<Transform, Collider>()
+        .write(SystemResource::Broadphase);
+}
+
+void BroadphaseSystem::update(ECS &ecs, float deltaTime)
+{
+    broadphase->beginFrame();
+
+    // Projectiles query the broadphase rather than live in it
+    ecs.view<Transform, Collider>().each([this](EntityID entityID, Transform &transform, Collider &collider)
+    {
+        if ((collider.layer & CollisionLayer::BODIES) == 0)
+            return;
+
+        float halfWidth = collider.width / 2.0f;
+        float halfHeight = collider.height / 2.0f;
+        broadphase->update(entityID, AABB{transform.x - halfWidth, transform.y - halfHeight,
+                                          transform.x + halfWidth, transform.y + halfHeight},
+                           collider.layer);
+    });
+
+    broadphase->endFrame();
+}
+
+void BroadphaseSystem::loadColliderConfig(const json &config)
+{
+    std::vector<float> sizes;
+    auto addCollider = [&sizes](const json &entity)
+    {
+        if (entity.contains("collider"))
+        {
+            const json &collider = entity["collider"];
+            sizes.push_back(std::max(collider.value("width", 0.0f), collider.value("height", 0.0f)));
+        }
+    };
+
+    if (config.contains("player"))
+    {
+        addCollider(config["player"]);
+    }
+    if (config.contains("mobs"))
+    {
+        for (const json &mobConfig : config["mobs"])
+        {
+            addCollider(mobConfig);
+        }
+    }
+
+    float typicalSize = 64.0f;
+    if (sizes.empty())
+    {
+        std::cerr << "Warning: No collider sizes found, using default broadphase sizing" << std::endl;
+    }
+    else
+    {
+        // The median collider keeps ordinary mobs within 1-4 grid cells; the
+        // few large ones (Mob King) just span more cells
+        std::nth_element(sizes.begin(), sizes.begin() + sizes.size() / 2, sizes.end());
+        typicalSize = sizes[sizes.size() / 2];
+    }
+
+    broadphase = createBroadphase(GameSettings::getInstance().getBroadphaseType(), typicalSize);
+    std::cout << "Broadphase: " << broadphase->getName() << " (typical collider size " << typicalSize
+              << ", " << batchOverlapKernelName() << " overlap kernel)" << std::endl;
+}
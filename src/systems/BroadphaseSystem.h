@@ -0,0 +1,28 @@
+#pragma once
+#include "System.h"
+#include "../physics/Broadphase.h"
+#include <nlohmann/json.hpp>
+#include <memory>
+
+using json = nlohmann::json;
+
+// Refreshes the broadphase with player and mob colliders (the BODIES
+// collision layers) once per frame so ProjectileSystem and CollisionSystem
+// only test nearby pairs. The implementation is chosen by "collision.broadphase" in gameSettings.json.
+class BroadphaseSystem : public System
+{
+public:
+    BroadphaseSystem();
+
+    void update(ECS &ecs, float deltaTime) override;
+    SystemAccess getAccess() const override;
+
+    // Sizes the broadphase from the collider dimensions in entities.json.
+    // Recreates it, so hand out getBroadphase() only after calling this.
+    void loadColliderConfig(const json &config);
+
+    const Broadphase &getBroadphase() const { return *broadphase; }
+
+private:
+    std::unique_ptr<Broadphase> broadphase;
+};
@@ -1,87 +1,137 @@
 #include "CollisionSystem.h"
 #include "../components/Components.h"
-#include <iostream>
+#include "../core/Profiler.h"
+#include "../physics/SweptAABB.h"
+#include <algorithm>
+
+SystemAccess CollisionSystem::getAccess() const
+{
+    return SystemAccess()
+        .read<Transform, Collider, Projectile>()
+        .read(SystemResource::Broadphase)
+        .read(SystemResource::GameState)
+        .write(SystemResource::Contacts);
+}
 
 void CollisionSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 {
+    contacts.clear();
+
     // Only check collisions during gameplay
     if (gameManager.currentState != GameManager::PLAYING)
     {
         return;
     }
 
-    // Get all entities with PlayerTag
-    auto &playerTags = ecs.getComponents<PlayerTag>();
-    auto &mobTags = ecs.getComponents<MobTag>();
-
-    // Check collisions between all players and mobs
-    for (auto &[playerEntityID, playerTag] : playerTags)
+    // Every collider looks for the bodies its mask allows. Bullets aren't in
+    // the broadphase, so they always ask; a body only asks for bodies on a
+    // higher layer bit, so a player-mob pair is found from the player's side
+    // alone. The queries only read, so they run in parallel into per-thread lists.
+    PerThread<std::vector<Contact>> contactLists(jobSystem);
+    auto findContacts = [&](EntityID entityID, Transform &transform, Collider &collider)
     {
-        // Get player components
-        auto *playerTransform = ecs.getComponent<Transform>(playerEntityID);
-        auto *playerCollider = ecs.getComponent<Collider>(playerEntityID);
-
-        if (!playerTransform || !playerCollider)
-            continue;
-
-        for (auto &[mobEntityID, mobTag] : mobTags)
+        std::uint32_t mask = collider.mask & CollisionLayer::BODIES;
+        bool isBody = (collider.layer & CollisionLayer::BODIES) != 0;
+        if (isBody)
         {
-            // Get mob components
-            auto *mobTransform = ecs.getComponent<Transform>(mobEntityID);
-            auto *mobCollider = ecs.getComponent<Collider>(mobEntityID);
+            mask &= ~((collider.layer << 1) - 1);
+        }
+        if (mask == 0)
+            return;
 
-            if (!mobTransform || !mobCollider)
-                continue;
+        std::vector<Contact> &found = contactLists.local();
+        const Projectile *projectile = isBody ? nullptr : ecs.getComponent<Projectile>(entityID);
+        if (!projectile)
+        {
+            // Bodies touching edge to edge collide
+            AABB bounds = colliderBounds(transform.x, transform.y, collider);
+            forEachCandidate(ecs, bounds, mask, [&](EntityID otherID, const Transform &otherTransform, const Collider &otherCollider)
+            {
+                if (touches(bounds, otherTransform, otherCollider))
+                {
+                    found.push_back({entityID, otherID, collider.layer | otherCollider.layer, 0.0f});
+                }
+            });
+            return;
+        }
 
-            // Check for collision
-            if (checkCollision(*playerTransform, *playerCollider,
-                               *mobTransform, *mobCollider))
+        // A bullet has to overlap a target somewhere between where this tick's
+        // move started and where it ended; targets are taken where they are now
+        AABB start = colliderBounds(transform.previousX, transform.previousY, collider);
+        float dx = transform.x - transform.previousX;
+        float dy = transform.y - transform.previousY;
+        forEachCandidate(ecs, sweptBounds(start, dx, dy), mask, [&](EntityID otherID, const Transform &otherTransform, const Collider &otherCollider)
+        {
+            float time;
+            if (sweepAABB(start, dx, dy, colliderBounds(otherTransform.x, otherTransform.y, otherCollider), time))
             {
-                handlePlayerMobCollision(ecs, gameManager, playerEntityID, mobEntityID);
-                return; // Exit early since game is over
+                found.push_back({entityID, otherID, collider.layer | otherCollider.layer, time});
             }
+        });
+    };
+
+    auto colliders = ecs.view<Transform, Collider>();
+    {
+        PROFILE_SCOPE("collision queries");
+        if (jobSystem)
+        {
+            jobSystem->parallelForEach(colliders, 4, findContacts);
+        }
+        else
+        {
+            colliders.each(findContacts);
         }
     }
-}
 
-bool CollisionSystem::checkCollision(const Transform &pos1, const Collider &col1,
-                                     const Transform &pos2, const Collider &col2)
-{
-    // Calculate bounding boxes
-    float left1 = pos1.x - col1.width / 2.0f;
-    float right1 = pos1.x + col1.width / 2.0f;
-    float top1 = pos1.y - col1.height / 2.0f;
-    float bottom1 = pos1.y + col1.height / 2.0f;
-
-    float left2 = pos2.x - col2.width / 2.0f;
-    float right2 = pos2.x + col2.width / 2.0f;
-    float top2 = pos2.y - col2.height / 2.0f;
-    float bottom2 = pos2.y + col2.height / 2.0f;
+    PROFILE_SCOPE("collision merge");
+    for (std::size_t i = 0; i < contactLists.size(); i++)
+    {
+        contacts.insert(contacts.end(), contactLists[i].begin(), contactLists[i].end());
+    }
 
-    // Check for overlap
-    return !(left1 > right2 || right1 < left2 || top1 > bottom2 || bottom1 < top2);
+    // A fixed order, so consumers see the same sequence whatever the thread count
+    std::sort(contacts.begin(), contacts.end(), [](const Contact &x, const Contact &y)
+    {
+        if (x.a != y.a)
+            return x.a < y.a;
+        if (x.time != y.time)
+            return x.time < y.time;
+        return x.b < y.b;
+    });
 }
 
-void CollisionSystem::handlePlayerMobCollision(ECS &ecs, GameManager &gameManager,
-                                               EntityID playerEntity, EntityID mobEntity)
+template <typename Fn>
+void CollisionSystem::forEachCandidate(ECS &ecs, const AABB &bounds, std::uint32_t mask, Fn &&fn) const
 {
-    if (gameManager.isDualPlayer())
+    if (broadphase)
     {
-        std::cout << "Player hit by mob! Mob King Wins!" << std::endl;
-        gameManager.gameOver(GameManager::MOB_KING);
-    }
-    else
-    {
-        std::cout << "Player hit by mob! Game Over!" << std::endl;
-        gameManager.gameOver();
+        broadphase->query(bounds, mask, [&](EntityID candidate)
+        {
+            if (!ecs.isPendingRemoval(candidate))
+            {
+                fn(candidate, *ecs.getComponent<Transform>(candidate), *ecs.getComponent<Collider>(candidate));
+            }
+        });
+        return;
     }
 
-    // Play death sound effect
-    if (audioSystem)
+    for (auto [otherID, otherTransform, otherCollider] : ecs.view<Transform, Collider>())
     {
-        audioSystem->playSound("gameover");
+        if ((otherCollider.layer & mask) != 0)
+        {
+            fn(otherID, otherTransform, otherCollider);
+        }
     }
+}
 
-    // Optional: Remove the mob entity that caused the collision
-    ecs.removeEntity(mobEntity);
+bool CollisionSystem::touches(const AABB &bounds, const Transform &transform, const Collider &collider)
+{
+    return bounds.overlaps(colliderBounds(transform.x, transform.y, collider));
+}
+
+AABB CollisionSystem::colliderBounds(float x, float y, const Collider &collider)
+{
+    float halfWidth = collider.width / 2.0f;
+    float halfHeight = collider.height / 2.0f;
+    return AABB{x - halfWidth, y - halfHeight, x + halfWidth, y + halfHeight};
 }
@@ -2,21 +2,52 @@
 #include "System.h"
 #include "../core/ECS.h"
 #include "../components/Components.h"
+#include "../physics/Broadphase.h"
 #include "../managers/GameManager.h"
-#include "../systems/AudioSystem.h"
+#include <vector>
 
+// One touching pair found this frame. `a` is the collider that looked for
+// contacts (a bullet, or the body on the lower layer bit), `b` the body it
+// touches; `layers` is both colliders' layer bits OR'ed together, so a
+// consumer tells pair types apart with one compare. `time` is how far along
+// a's move this frame the contact began (0..1; 0 for resting contacts).
+struct Contact
+{
+    EntityID a;
+    EntityID b;
+    std::uint32_t layers;
+    float time;
+};
+
+// The collision stage: finds every colliding pair once per frame, for every
+// pair type the collider masks allow, and publishes them as one array in a
+// fixed order. Bullets are swept from their previous position, so they hit
+// whatever they passed through however large the frame step. It changes
+// nothing itself; DamageSystem applies the results.
 class CollisionSystem : public System
 {
 private:
-    AudioSystem *audioSystem;
+    const Broadphase *broadphase = nullptr;
+    JobSystem *jobSystem = nullptr;
+    std::vector<Contact> contacts;
 
 public:
-    CollisionSystem(AudioSystem *audio) : audioSystem(audio) {}
     void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
+    SystemAccess getAccess() const override;
+
+    // Limits the tests to nearby bodies when set; otherwise tests all
+    void setBroadphase(const Broadphase *spatialIndex) { broadphase = spatialIndex; }
+
+    // Splits the per-collider queries across worker threads when set
+    void setJobSystem(JobSystem *jobs) { jobSystem = jobs; }
+
+    // This frame's contacts, sorted by a, then time, then b; a bullet's
+    // first contact is the first target on its path
+    const std::vector<Contact> &getContacts() const { return contacts; }
 
 private:
-    bool checkCollision(const Transform &pos1, const Collider &col1,
-                        const Transform &pos2, const Collider &col2);
-    void handlePlayerMobCollision(ECS &ecs, GameManager &gameManager,
-                                  EntityID playerEntity, EntityID mobEntity);
+    template <typename Fn>
+    void forEachCandidate(ECS &ecs, const AABB &bounds, std::uint32_t mask, Fn &&fn) const;
+    static bool touches(const AABB &bounds, const Transform &transform, const Collider &collider);
+    static AABB colliderBounds(float x, float y, const Collider &collider);
 };
@@ -0,0 +1,191 @@
+#include "DamageSystem.h"
+#include "AudioSystem.h"
+#include <iostream>
+
+SystemAccess DamageSystem::getAccess() const
+{
+    return SystemAccess()
+        .read<Collider, Projectile, MobKing>()
+        .write<Health>()
+        .read(SystemResource::Contacts)
+        .write(SystemResource::Structural)
+        .write(SystemResource::GameState)
+        .write(SystemResource::Audio)
+        .write(SystemResource::Network);
+}
+
+void DamageSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
+{
+    // Hitscan shots were fired before anything moved this frame, so they
+    // land ahead of the collision contacts
+    if (weaponSystem)
+    {
+        for (const HitscanHit &hit : weaponSystem->getHitscanHits())
+        {
+            if (gameManager.currentState != GameManager::PLAYING)
+            {
+                return;
+            }
+            if (!ecs.isPendingRemoval(hit.target))
+            {
+                applyHitscanHit(ecs, gameManager, hit);
+            }
+        }
+    }
+
+    if (!collisionSystem)
+    {
+        return;
+    }
+
+    for (const Contact &contact : collisionSystem->getContacts())
+    {
+        // The game may have ended on an earlier contact this frame
+        if (gameManager.currentState != GameManager::PLAYING)
+        {
+            return;
+        }
+
+        // Removals are deferred to the sync point, so an entity an earlier
+        // contact used up (a spent bullet, a killed mob) is still pending here
+        if (ecs.isPendingRemoval(contact.a) || ecs.isPendingRemoval(contact.b))
+        {
+            continue;
+        }
+
+        switch (contact.layers)
+        {
+        case CollisionLayer::PLAYER | CollisionLayer::MOB:
+        case CollisionLayer::PLAYER | CollisionLayer::MOB_KING:
+            applyPlayerMobContact(ecs, gameManager, contact.b);
+            break;
+        case CollisionLayer::PLAYER_BULLET | CollisionLayer::MOB:
+        case CollisionLayer::PLAYER_BULLET | CollisionLayer::MOB_KING:
+            applyMobHit(ecs, gameManager, contact.a, contact.b);
+            break;
+        case CollisionLayer::MOB_BULLET | CollisionLayer::PLAYER:
+            applyPlayerHit(ecs, gameManager, contact.a);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+void DamageSystem::applyPlayerMobContact(ECS &ecs, GameManager &gameManager, EntityID mobID)
+{
+    killPlayer(gameManager, "Player hit by mob!");
+
+    // Optional: Remove the mob entity that caused the collision
+    bool isMobKing = ecs.hasComponents<MobKing>(mobID);
+    removeEntity(ecs, gameManager, mobID, isMobKing ? RemovedEntityType::MOB_KING : RemovedEntityType::MOB);
+}
+
+void DamageSystem::applyHitscanHit(ECS &ecs, GameManager &gameManager, const HitscanHit &hit)
+{
+    switch (hit.layers)
+    {
+    case CollisionLayer::PLAYER_BULLET | CollisionLayer::MOB:
+    case CollisionLayer::PLAYER_BULLET | CollisionLayer::MOB_KING:
+        damageMob(ecs, gameManager, hit.target, hit.damage);
+        break;
+    case CollisionLayer::MOB_BULLET | CollisionLayer::PLAYER:
+        killPlayer(gameManager, "Mob shot hit player!");
+        break;
+    default:
+        break;
+    }
+}
+
+void DamageSystem::applyMobHit(ECS &ecs, GameManager &gameManager, EntityID projID, EntityID mobID)
+{
+    float damage = ecs.getComponent<Projectile>(projID)->damage;
+    removeEntity(ecs, gameManager, projID, RemovedEntityType::PROJECTILE);
+    damageMob(ecs, gameManager, mobID, damage);
+}
+
+void DamageSystem::damageMob(ECS &ecs, GameManager &gameManager, EntityID mobID, float damage)
+{
+    bool isMobKing = ecs.hasComponents<MobKing>(mobID);
+    bool mobDestroyed = false;
+
+    // Check if this mob has health (like Mob King)
+    Health *mobHealth = ecs.getComponent<Health>(mobID);
+    if (mobHealth)
+    {
+        // Damage the mob's health
+        mobHealth->currentHealth -= damage;
+        std::cout << "Player shot hit mob! Damage: " << damage
+                  << ", Health remaining: " << mobHealth->currentHealth << std::endl;
+
+        // Remove the mob if health drops to 0 or below
+        if (mobHealth->currentHealth <= 0)
+        {
+            mobDestroyed = true;
+            if (isMobKing)
+            {
+                if (gameManager.isDualPlayer())
+                {
+                    std::cout << "Mob King defeated! Player Wins!" << std::endl;
+                    gameManager.gameOver(GameManager::PLAYER);
+                }
+                else
+                {
+                    std::cout << "Mob King defeated! Victory!" << std::endl;
+                }
+            }
+        }
+    }
+    else
+    {
+        // Regular mob without health - one hit destroys it
+        mobDestroyed = true;
+        std::cout << "Player shot hit mob!" << std::endl;
+    }
+
+    if (mobDestroyed)
+    {
+        removeEntity(ecs, gameManager, mobID, isMobKing ? RemovedEntityType::MOB_KING : RemovedEntityType::MOB);
+    }
+}
+
+void DamageSystem::applyPlayerHit(ECS &ecs, GameManager &gameManager, EntityID projID)
+{
+    killPlayer(gameManager, "Mob projectile hit player!");
+    removeEntity(ecs, gameManager, projID, RemovedEntityType::PROJECTILE);
+}
+
+void DamageSystem::killPlayer(GameManager &gameManager, const char *cause)
+{
+    if (gameManager.isDualPlayer())
+    {
+        std::cout << cause << " Mob King Wins!" << std::endl;
+        gameManager.gameOver(GameManager::MOB_KING);
+    }
+    else
+    {
+        std::cout << cause << " Game Over!" << std::endl;
+        gameManager.gameOver();
+    }
+
+    // Play death sound effect
+    if (audioSystem)
+    {
+        audioSystem->playSound("gameover");
+    }
+}
+
+void DamageSystem::removeEntity(ECS &ecs, GameManager &gameManager, EntityID entityID, RemovedEntityType type)
+{
+    // Clients mirror the host's removals
+    if (networkSystem && gameManager.isMultiplayer())
+    {
+        uint32_t networkID = networkSystem->getNetworkEntityID(entityID);
+        if (networkID != 0)
+        {
+            networkSystem->queueEntityRemove(networkID, type);
+        }
+    }
+
+    ecs.commands().removeEntity(entityID);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "System.h"
+#include "CollisionSystem.h"
+#include "NetworkSystem.h"
+#include "WeaponSystem.h"
+#include "../core/ECS.h"
+#include "../managers/GameManager.h"
+#include "../components/Components.h"
+
+// Applies the frame's hitscan hits from WeaponSystem, then its contacts from
+// CollisionSystem, in order: bullet damage and kills, player deaths (game
+// over), their sounds, and the removals the client has to mirror. Contacts
+// whose entities an earlier contact already removed are skipped, so a bullet
+// is spent on its first live target.
+class DamageSystem : public System
+{
+private:
+    const CollisionSystem *collisionSystem = nullptr;
+    const WeaponSystem *weaponSystem = nullptr;
+    class AudioSystem *audioSystem = nullptr;
+    NetworkSystem *networkSystem = nullptr;
+
+public:
+    void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
+    SystemAccess getAccess() const override;
+
+    void setCollisionSystem(const CollisionSystem *collision) { collisionSystem = collision; }
+    void setWeaponSystem(const WeaponSystem *weapons) { weaponSystem = weapons; }
+    void setAudioSystem(class AudioSystem *audio) { audioSystem = audio; }
+    void setNetworkSystem(NetworkSystem *network) { networkSystem = network; }
+
+private:
+    void applyPlayerMobContact(ECS &ecs, GameManager &gameManager, EntityID mobID);
+    void applyHitscanHit(ECS &ecs, GameManager &gameManager, const HitscanHit &hit);
+    void applyMobHit(ECS &ecs, GameManager &gameManager, EntityID projID, EntityID mobID);
+    void applyPlayerHit(ECS &ecs, GameManager &gameManager, EntityID projID);
+    void damageMob(ECS &ecs, GameManager &gameManager, EntityID mobID, float damage);
+    void killPlayer(GameManager &gameManager, const char *cause);
+
+    // Queues the removal and, on a multiplayer host, the client's copy of it
+    void removeEntity(ECS &ecs, GameManager &gameManager, EntityID entityID, RemovedEntityType type);
+};
@@ -6,13 +6,12 @@
 
 InputSystem::InputSystem()
 {
-    keyboardState = SDL_GetKeyboardState(nullptr);
 }
 
 void InputSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 {
     // Handle game state inputs (only for non-menu states)
-    if (keyboardState[SDL_SCANCODE_SPACE])
+    if (isKeyDown(SDL_SCANCODE_SPACE))
     {
         if (gameManager.currentState == GameManager::GAME_OVER)
         {
@@ -43,7 +42,7 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
     }
 
     // Handle restart input (R key)
-    if (keyboardState[SDL_SCANCODE_R])
+    if (isKeyDown(SDL_SCANCODE_R))
     {
         if (gameManager.currentState == GameManager::LEVEL_COMPLETE ||
             gameManager.currentState == GameManager::PLAYING)
@@ -88,22 +87,22 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
             bool movingVertical = false;
 
             // Update velocity based on input
-            if (keyboardState[SDL_SCANCODE_LEFT] || keyboardState[SDL_SCANCODE_A])
+            if (isKeyDown(SDL_SCANCODE_LEFT) || isKeyDown(SDL_SCANCODE_A))
             {
                 velocity->x = -1.0f;
                 movingHorizontal = true;
             }
-            if (keyboardState[SDL_SCANCODE_RIGHT] || keyboardState[SDL_SCANCODE_D])
+            if (isKeyDown(SDL_SCANCODE_RIGHT) || isKeyDown(SDL_SCANCODE_D))
             {
                 velocity->x = 1.0f;
                 movingHorizontal = true;
             }
-            if (keyboardState[SDL_SCANCODE_UP] || keyboardState[SDL_SCANCODE_W])
+            if (isKeyDown(SDL_SCANCODE_UP) || isKeyDown(SDL_SCANCODE_W))
             {
                 velocity->y = -1.0f;
                 movingVertical = true;
             }
-            if (keyboardState[SDL_SCANCODE_DOWN] || keyboardState[SDL_SCANCODE_S])
+            if (isKeyDown(SDL_SCANCODE_DOWN) || isKeyDown(SDL_SCANCODE_S))
             {
                 velocity->y = 1.0f;
                 movingVertical = true;
@@ -157,22 +156,22 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
                 bool movingVertical = false;
 
                 // DUAL PLAYER LOCAL MODE: IJKL movement, P to shoot
-                if (keyboardState[SDL_SCANCODE_J]) // Left
+                if (isKeyDown(SDL_SCANCODE_J)) // Left
                 {
                     velocity->x = -1.0f;
                     movingHorizontal = true;
                 }
-                if (keyboardState[SDL_SCANCODE_L]) // Right
+                if (isKeyDown(SDL_SCANCODE_L)) // Right
                 {
                     velocity->x = 1.0f;
                     movingHorizontal = true;
                 }
-                if (keyboardState[SDL_SCANCODE_I]) // Up
+                if (isKeyDown(SDL_SCANCODE_I)) // Up
                 {
                     velocity->y = -1.0f;
                     movingVertical = true;
                 }
-                if (keyboardState[SDL_SCANCODE_K]) // Down
+                if (isKeyDown(SDL_SCANCODE_K)) // Down
                 {
                     velocity->y = 1.0f;
                     movingVertical = true;
@@ -204,7 +203,7 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
                 }
 
                 // P key to shoot - handle directly in local mode
-                if (keyboardState[SDL_SCANCODE_P])
+                if (isKeyDown(SDL_SCANCODE_P))
                 {
                     auto *weapon = ecs.getComponent<Weapon>(entityID);
                     if (weapon)
@@ -219,46 +218,18 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 
 void InputSystem::clearAllMobs(ECS &ecs)
 {
-    // Get all entities with MobTag and remove them
-    auto &mobTags = ecs.getComponents<MobTag>();
-    std::vector<EntityID> mobsToRemove;
-
-    // Collect all mob entity IDs
-    for (auto &[entityID, mobTag] : mobTags)
-    {
-        mobsToRemove.push_back(entityID);
-    }
-
-    // Remove all mob entities
-    for (EntityID mobID : mobsToRemove)
-    {
-        ecs.removeEntity(mobID);
-    }
+    ecs.removeEntitiesWith<MobTag>();
 }
 
 void InputSystem::clearAllProjectiles(ECS &ecs)
 {
-    // Get all entities with ProjectileTag and remove them
-    auto &projectileTags = ecs.getComponents<ProjectileTag>();
-    std::vector<EntityID> projectilesToRemove;
-
-    // Collect all projectile entity IDs
-    for (auto &[entityID, projectileTag] : projectileTags)
-    {
-        projectilesToRemove.push_back(entityID);
-    }
-
-    // Remove all projectile entities
-    for (EntityID projectileID : projectilesToRemove)
-    {
-        ecs.removeEntity(projectileID);
-    }
+    ecs.removeEntitiesWith<ProjectileTag>();
 }
 
 void InputSystem::update(ECS &ecs, GameManager &gameManager, NetworkSystem *networkSystem, float deltaTime)
 {
     // Handle general inputs (menus, restart, etc.) but not player movement
-    if (keyboardState[SDL_SCANCODE_SPACE])
+    if (isKeyDown(SDL_SCANCODE_SPACE))
     {
         if (gameManager.currentState == GameManager::GAME_OVER)
         {
@@ -273,7 +244,7 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, NetworkSystem *netw
         }
     }
 
-    if (keyboardState[SDL_SCANCODE_R])
+    if (isKeyDown(SDL_SCANCODE_R))
     {
         if (gameManager.currentState == GameManager::LEVEL_COMPLETE ||
             gameManager.currentState == GameManager::PLAYING)
@@ -306,22 +277,22 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, NetworkSystem *netw
                 bool movingHorizontal = false, movingVertical = false;
 
                 // Process WASD input locally
-                if (keyboardState[SDL_SCANCODE_W])
+                if (isKeyDown(SDL_SCANCODE_W))
                 {
                     velY = -1.0f;
                     movingVertical = true;
                 }
-                if (keyboardState[SDL_SCANCODE_S])
+                if (isKeyDown(SDL_SCANCODE_S))
                 {
                     velY = 1.0f;
                     movingVertical = true;
                 }
-                if (keyboardState[SDL_SCANCODE_A])
+                if (isKeyDown(SDL_SCANCODE_A))
                 {
                     velX = -1.0f;
                     movingHorizontal = true;
                 }
-                if (keyboardState[SDL_SCANCODE_D])
+                if (isKeyDown(SDL_SCANCODE_D))
                 {
                     velX = 1.0f;
                     movingHorizontal = true;
@@ -367,9 +338,7 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, NetworkSystem *netw
                 }
 
                 // Get mouse state for shooting (handled by WeaponSystem)
-                int mouseX, mouseY;
-                Uint32 mouseButtons = SDL_GetMouseState(&mouseX, &mouseY);
-                bool shooting = (mouseButtons & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0;
+                bool shooting = input && input->isMouseButtonDown(SDL_BUTTON_LEFT);
 
                 // Mouse state is handled locally by WeaponSystem
                 // Position sync is handled by sendEntityPositionUpdate above
@@ -403,11 +372,11 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, NetworkSystem *netw
                     bool shooting = false;
 
                     // Debug keyboard state
-                    bool wPressed = keyboardState[SDL_SCANCODE_W];
-                    bool aPressed = keyboardState[SDL_SCANCODE_A];
-                    bool sPressed = keyboardState[SDL_SCANCODE_S];
-                    bool dPressed = keyboardState[SDL_SCANCODE_D];
-                    bool spacePressed = keyboardState[SDL_SCANCODE_SPACE];
+                    bool wPressed = isKeyDown(SDL_SCANCODE_W);
+                    bool aPressed = isKeyDown(SDL_SCANCODE_A);
+                    bool sPressed = isKeyDown(SDL_SCANCODE_S);
+                    bool dPressed = isKeyDown(SDL_SCANCODE_D);
+                    bool spacePressed = isKeyDown(SDL_SCANCODE_SPACE);
 
                     if (wPressed || aPressed || sPressed || dPressed || spacePressed)
                     {
@@ -416,29 +385,29 @@ void InputSystem::update(ECS &ecs, GameManager &gameManager, NetworkSystem *netw
                     }
 
                     // MULTIPLAYER MODE: WASD movement, SPACE to shoot
-                    if (keyboardState[SDL_SCANCODE_A]) // Left
+                    if (isKeyDown(SDL_SCANCODE_A)) // Left
                     {
                         velocity->x = -1.0f;
                         movingHorizontal = true;
                     }
-                    if (keyboardState[SDL_SCANCODE_D]) // Right
+                    if (isKeyDown(SDL_SCANCODE_D)) // Right
                     {
                         velocity->x = 1.0f;
                         movingHorizontal = true;
                     }
-                    if (keyboardState[SDL_SCANCODE_W]) // Up
+                    if (isKeyDown(SDL_SCANCODE_W)) // Up
                     {
                         velocity->y = -1.0f;
                         movingVertical = true;
                     }
-                    if (keyboardState[SDL_SCANCODE_S]) // Down
+                    if (isKeyDown(SDL_SCANCODE_S)) // Down
                     {
                         velocity->y = 1.0f;
                         movingVertical = true;
                     }
 
                     // SPACE key to shoot
-                    if (keyboardState[SDL_SCANCODE_SPACE])
+                    if (isKeyDown(SDL_SCANCODE_SPACE))
                     {
                         shooting = true;
                     }
@@ -1,6 +1,7 @@
 #pragma once
 #include "System.h"
 #include "../managers/GameManager.h"
+#include "../core/InputFrame.h"
 #include <SDL2/SDL.h>
 
 // Forward declaration
@@ -9,12 +10,16 @@ class NetworkSystem;
 class InputSystem : public System
 {
 private:
-    const Uint8 *keyboardState;
+    const InputFrame *input = nullptr;
+    bool isKeyDown(SDL_Scancode key) const { return input && input->isKeyDown(key); }
     void clearAllMobs(ECS &ecs);
     void clearAllProjectiles(ECS &ecs);
 
 public:
     InputSystem();
+
+    // This tick's keyboard and mouse state, captured or replayed by Game
+    void setInput(const InputFrame *frame) { input = frame; }
     void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
     void update(ECS &ecs, GameManager &gameManager, NetworkSystem *networkSystem, float deltaTime);
 };
@@ -1,6 +1,7 @@
 #include "MenuSystem.h"
 #include "NetworkSystem.h"
 #include "../components/Components.h"
+#include "../core/Profiler.h"
 #include <iostream>
 
 MenuSystem::MenuSystem()
@@ -15,6 +16,8 @@ MenuSystem::~MenuSystem()
 
 void MenuSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 {
+    PROFILE_SCOPE("menu");
+
     // Handle menu when in menu state
     if (gameManager.currentState == GameManager::MENU)
     {
@@ -51,11 +51,13 @@ public:
     void cleanupMenuEntities(ECS &ecs);
     void setNetworkSystem(NetworkSystem *network) { networkSystem = network; }
 
+    // Runs a menu option's action ("singleplayer", "host", ...) as if chosen
+    void executeMenuAction(const std::string &action, GameManager &gameManager);
+
 private:
     void handleInput(GameManager &gameManager);
     void createMenuEntities(ECS &ecs);
     void updateMenuDisplay(ECS &ecs);
-    void executeMenuAction(const std::string &action, GameManager &gameManager);
     bool isKeyPressed(SDL_Scancode key);
     void loadCurrentMenuConfig();
 
@@ -1,19 +1,35 @@
 #include "MobSpawningSystem.h"
 #include "NetworkSystem.h"
 #include "../components/Components.h"
+#include "../core/Random.h"
 #include <iostream>
-#include <chrono>
 
 MobSpawningSystem::MobSpawningSystem(EntityFactory *factory, float screenW, float screenH)
     : entityFactory(factory), timeSinceLastSpawn(0.0f), spawnInterval(0.5f),
       screenWidth(screenW), screenHeight(screenH),
-      randomGenerator(std::chrono::steady_clock::now().time_since_epoch().count()),
+      randomGenerator(streamSeed(randomMasterSeed(), "mobSpawning")),
       mobTypeDistribution(0, 2), // 0-2 for 3 mob types
       positionDistribution(0.0f, 1.0f),
       speedDistribution(0.0f, 1.0f)
 {
 }
 
+void MobSpawningSystem::setRandomSeed(std::uint64_t masterSeed)
+{
+    randomGenerator.seed(streamSeed(masterSeed, "mobSpawning"));
+    mobTypeDistribution.reset();
+    positionDistribution.reset();
+    speedDistribution.reset();
+}
+
+SystemAccess MobSpawningSystem::getAccess() const
+{
+    return SystemAccess()
+        .read(SystemResource::GameState)
+        .write(SystemResource::Structural)
+        .write(SystemResource::Network);
+}
+
 void MobSpawningSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 {
     // Only spawn mobs during gameplay
@@ -34,7 +50,7 @@ void MobSpawningSystem::update(ECS &ecs, GameManager &gameManager, float deltaTi
 
         if (shouldCreateMobKing)
         {
-            spawnMobKing(ecs, gameManager);
+            EntityID mobKingEntity = spawnMobKing(ecs, gameManager);
             mobKingSpawned = true;
 
             // For networked multiplayer, send Mob King to client
@@ -49,7 +65,7 @@ void MobSpawningSystem::update(ECS &ecs, GameManager &gameManager, float deltaTi
                 float y = startPos["y"].get<float>();
 
                 // Send MOB_SPAWN message to client
-                networkSystem->sendMobSpawn(999, x, y, 0.0f, 0.0f, "mobKing"); // Use ID 999 for Mob King
+                networkSystem->sendMobSpawn(mobKingEntity, x, y, 0.0f, 0.0f, "mobKing");
             }
         }
         else
@@ -137,10 +153,7 @@ void MobSpawningSystem::spawnMob(ECS &ecs, GameManager &gameManager)
     }
 
     // Create Transform component
-    Transform transform;
-    transform.x = spawnX;
-    transform.y = spawnY;
-    transform.rotation = 0.0f;
+    Transform transform(spawnX, spawnY, 0.0f);
     ecs.addComponent(mobEntity, transform);
 
     // Add MovementDirection component for proper sprite orientation
@@ -170,6 +183,8 @@ void MobSpawningSystem::spawnMob(ECS &ecs, GameManager &gameManager)
     collider.width = colliderConfig["width"].get<float>();
     collider.height = colliderConfig["height"].get<float>();
     collider.isTrigger = colliderConfig["isTrigger"].get<bool>();
+    collider.layer = CollisionLayer::MOB;
+    collider.mask = CollisionLayer::maskFor(collider.layer);
     ecs.addComponent(mobEntity, collider);
 
     // Use the calculated velocity from spawn logic
@@ -203,6 +218,7 @@ void MobSpawningSystem::spawnMob(ECS &ecs, GameManager &gameManager)
         weapon.damage = combatConfig["damage"].get<float>();
         weapon.range = combatConfig["range"].get<float>();
         weapon.fireRate = combatConfig["fireRate"].get<float>();
+        weapon.hitscan = combatConfig.contains("hitscan") && combatConfig["hitscan"].get<bool>();
         weapon.fireTimer = 0.0f;
         weapon.canFire = true;
         weapon.ammoCount = 999; // Unlimited ammo for mobs
@@ -229,7 +245,7 @@ void MobSpawningSystem::spawnMob(ECS &ecs, GameManager &gameManager)
     }
 }
 
-void MobSpawningSystem::spawnMobKing(ECS &ecs, GameManager &gameManager)
+EntityID MobSpawningSystem::spawnMobKing(ECS &ecs, GameManager &gameManager)
 {
     std::cout << "Spawning Mob King!" << std::endl;
 
@@ -250,10 +266,7 @@ void MobSpawningSystem::spawnMobKing(ECS &ecs, GameManager &gameManager)
 
     // Set spawn position from config (right side of screen)
     json startPos = mobKingConfig["startPosition"];
-    Transform transform;
-    transform.x = startPos["x"].get<float>();
-    transform.y = startPos["y"].get<float>();
-    transform.rotation = 0.0f;
+    Transform transform(startPos["x"].get<float>(), startPos["y"].get<float>(), 0.0f);
     ecs.addComponent(mobKingEntity, transform);
 
     // Add MovementDirection component
@@ -285,6 +298,8 @@ void MobSpawningSystem::spawnMobKing(ECS &ecs, GameManager &gameManager)
     collider.width = colliderConfig["width"].get<float>();
     collider.height = colliderConfig["height"].get<float>();
     collider.isTrigger = colliderConfig["isTrigger"].get<bool>();
+    collider.layer = CollisionLayer::MOB_KING;
+    collider.mask = CollisionLayer::maskFor(collider.layer);
     ecs.addComponent(mobKingEntity, collider);
 
     // Initial velocity (player-controlled, starts stationary)
@@ -312,6 +327,7 @@ void MobSpawningSystem::spawnMobKing(ECS &ecs, GameManager &gameManager)
     weapon.damage = combatConfig["damage"].get<float>();
     weapon.range = combatConfig["range"].get<float>();
     weapon.fireRate = combatConfig["fireRate"].get<float>();
+    weapon.hitscan = combatConfig.contains("hitscan") && combatConfig["hitscan"].get<bool>();
     weapon.fireTimer = 0.0f;
     weapon.canFire = true;
     weapon.ammoCount = 999; // Unlimited ammo
@@ -322,6 +338,8 @@ void MobSpawningSystem::spawnMobKing(ECS &ecs, GameManager &gameManager)
               << ") with " << health.currentHealth << "/" << health.maxHealth << " health and combat abilities!" << std::endl;
     std::cout << "Mob King stats: Damage=" << weapon.damage << ", Range=" << weapon.range
               << ", Fire Rate=" << weapon.fireRate << std::endl;
+
+    return mobKingEntity;
 }
 
 EntityID MobSpawningSystem::createMobFromNetwork(ECS &ecs, uint32_t mobID, float x, float y, float velocityX, float velocityY, const std::string &mobType)
@@ -348,10 +366,7 @@ EntityID MobSpawningSystem::createMobFromNetwork(ECS &ecs, uint32_t mobID, float
     ecs.addComponent(mobEntity, EntityType{mobType});
 
     // Set transform from network data
-    Transform transform;
-    transform.x = x;
-    transform.y = y;
-    transform.rotation = 0.0f;
+    Transform transform(x, y, 0.0f);
     ecs.addComponent(mobEntity, transform);
 
     // Set velocity from network data (already scaled by speed on host)
@@ -421,6 +436,8 @@ EntityID MobSpawningSystem::createMobFromNetwork(ECS &ecs, uint32_t mobID, float
     collider.width = colliderConfig["width"].get<float>();
     collider.height = colliderConfig["height"].get<float>();
     collider.isTrigger = colliderConfig["isTrigger"].get<bool>();
+    collider.layer = mobType == "mobKing" ? CollisionLayer::MOB_KING : CollisionLayer::MOB;
+    collider.mask = CollisionLayer::maskFor(collider.layer);
     ecs.addComponent(mobEntity, collider);
 
     // Speed component - use the magnitude from network data as the final speed
@@ -443,6 +460,7 @@ EntityID MobSpawningSystem::createMobFromNetwork(ECS &ecs, uint32_t mobID, float
         weapon.damage = combatConfig["damage"].get<float>();
         weapon.range = combatConfig["range"].get<float>();
         weapon.fireRate = combatConfig["fireRate"].get<float>();
+        weapon.hitscan = combatConfig.contains("hitscan") && combatConfig["hitscan"].get<bool>();
         weapon.fireTimer = 0.0f;
         weapon.canFire = true;
         weapon.ammoCount = 999; // Unlimited ammo
@@ -30,12 +30,17 @@ private:
 public:
     MobSpawningSystem(EntityFactory *factory, float screenW, float screenH);
     void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
+    SystemAccess getAccess() const override;
     void reset()
     {
         mobKingSpawned = false;
         timeSinceLastSpawn = 0.0f;
     }
 
+    // Restarts the spawn stream from the master seed, so a run with the same
+    // seed spawns the same mobs in the same places
+    void setRandomSeed(std::uint64_t masterSeed);
+
     // Network integration
     void setNetworkSystem(NetworkSystem *network) { networkSystem = network; }
 
@@ -44,7 +49,7 @@ public:
 
 private:
     void spawnMob(ECS &ecs, GameManager &gameManager);
-    void spawnMobKing(ECS &ecs, GameManager &gameManager);
+    EntityID spawnMobKing(ECS &ecs, GameManager &gameManager);
     void setSpawnInterval(float interval) { spawnInterval = interval; }
 
     // Dual player state
@@ -2,23 +2,33 @@
 #include "../components/Components.h"
 #include <iostream>
 
+SystemAccess MovementSystem::getAccess() const
+{
+    return SystemAccess().read<Velocity, Speed, MobKing, PlayerTag>().write<Transform>();
+}
+
 void MovementSystem::update(ECS &ecs, float deltaTime)
 {
-    auto &transforms = ecs.getComponents<Transform>();
     static float debugTimer = 0.0f;
     debugTimer += deltaTime;
 
-    for (auto &[entityID, transform] : transforms)
+    // each() lets the archetype backend stream whole chunk columns
+    auto integrate = [deltaTime](EntityID, Transform &transform, Velocity &velocity, Speed &speed)
     {
-        auto *velocity = ecs.getComponent<Velocity>(entityID);
-        auto *speed = ecs.getComponent<Speed>(entityID);
+        // Apply velocity * speed * deltaTime to position
+        transform.x += velocity.x * speed.value * deltaTime;
+        transform.y += velocity.y * speed.value * deltaTime;
+    };
 
-        if (velocity && speed)
-        {
-            // Apply velocity * speed * deltaTime to position
-            transform.x += velocity->x * speed->value * deltaTime;
-            transform.y += velocity->y * speed->value * deltaTime;
-        }
+    auto movers = ecs.view<Transform, Velocity, Speed>();
+    if (jobSystem)
+    {
+        // Each entity only writes its own Transform, so blocks run independently
+        jobSystem->parallelForEach(movers, 4, integrate);
+    }
+    else
+    {
+        movers.each(integrate);
     }
 
     // Debug entity positions every 2 seconds
@@ -5,7 +5,14 @@ class MovementSystem : public System
 {
 public:
     void update(ECS &ecs, float deltaTime) override;
+    SystemAccess getAccess() const override;
 
     // Network synchronization
     void updateEntityFromNetwork(ECS &ecs, uint32_t entityID, float x, float y, float velocityX, float velocityY, const std::string &entityType);
+
+    // Splits integration across worker threads when set
+    void setJobSystem(JobSystem *jobs) { jobSystem = jobs; }
+
+private:
+    JobSystem *jobSystem = nullptr;
 };
@@ -3,11 +3,34 @@
 #include "WeaponSystem.h"
 #include "MovementSystem.h"
 #include "../components/Components.h"
+#include "../core/Profiler.h"
+#include "../core/Random.h"
+#include <algorithm>
 #include <iostream>
 #include <cstring>
+#include <random>
+
+namespace
+{
+    static_assert(sizeof(EntityRemoveBatchData) <= sizeof(NetworkMessage::data), "removal batch must fit one message");
+
+    const char *removedEntityTypeName(uint8_t type)
+    {
+        switch (static_cast<RemovedEntityType>(type))
+        {
+        case RemovedEntityType::PROJECTILE:
+            return "projectile";
+        case RemovedEntityType::MOB:
+            return "mob";
+        case RemovedEntityType::MOB_KING:
+            return "mobKing";
+        }
+        return "unknown";
+    }
+}
 
 NetworkSystem::NetworkSystem()
-    : currentState(NetworkState::DISCONNECTED), isHost(false), localPlayerID(0), serverSocket(nullptr), socketSet(nullptr), hostIP(""), port(7777), connectionTimeout(5000) // 5 seconds
+    : currentState(NetworkState::DISCONNECTED), isHost(false), localPlayerID(0), randomSeed(randomMasterSeed()), serverSocket(nullptr), socketSet(nullptr), hostIP(""), port(7777), connectionTimeout(5000) // 5 seconds
       ,
       lastHeartbeat(0), debugMode(false) // Disable debug mode by default for cleaner output
 {
@@ -57,6 +80,8 @@ void NetworkSystem::shutdownSDLNet()
 
 void NetworkSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 {
+    PROFILE_SCOPE("network");
+
     if (currentState == NetworkState::DISCONNECTED)
         return;
 
@@ -216,12 +241,16 @@ void NetworkSystem::resetConnection()
 
     remoteConnection.isConnected = false;
     remoteConnection.playerID = 0;
+    roundTripMilliseconds = 0.0f;
+    incomingQueueDepth = 0;
+    outgoingQueueDepth = 0;
 
     // Clear message queues
     while (!incomingMessages.empty())
         incomingMessages.pop();
     while (!outgoingMessages.empty())
         outgoingMessages.pop();
+    pendingRemovals.clear();
 }
 
 bool NetworkSystem::handleIncomingConnections()
@@ -268,6 +297,8 @@ bool NetworkSystem::handleIncomingConnections()
 
 bool NetworkSystem::receiveMessages()
 {
+    PROFILE_SCOPE("network receive");
+
     if (currentState == NetworkState::DISCONNECTED)
         return false;
 
@@ -291,10 +322,12 @@ bool NetworkSystem::receiveMessages()
 
             if (bytesReceived > 0)
             {
+                receivedBytes += static_cast<uint64_t>(bytesReceived);
                 NetworkMessage message;
                 if (deserializeMessage(headerBuffer, bytesReceived, message))
                 {
                     incomingMessages.push(message);
+                    messagesReceived++;
                     receivedAny = true;
                 }
             }
@@ -312,6 +345,10 @@ bool NetworkSystem::receiveMessages()
 
 void NetworkSystem::processIncomingMessages(ECS &ecs, GameManager &gameManager)
 {
+    PROFILE_SCOPE("network process");
+
+    incomingQueueDepth = incomingMessages.size();
+
     while (hasIncomingMessages())
     {
         NetworkMessage message = popIncomingMessage();
@@ -360,15 +397,20 @@ void NetworkSystem::processIncomingMessages(ECS &ecs, GameManager &gameManager)
             break;
 
         case MessageType::PING:
-            // Respond with pong
+            // Respond with pong, echoing the ping's send time
             {
                 NetworkMessage pongMsg(MessageType::PONG, localPlayerID);
+                pongMsg.timestamp = message.timestamp;
                 sendMessage(pongMsg);
             }
             break;
 
         case MessageType::PONG:
             remoteConnection.lastPingTime = SDL_GetTicks();
+            {
+                float sample = static_cast<float>(remoteConnection.lastPingTime - message.timestamp);
+                roundTripMilliseconds = roundTripMilliseconds == 0.0f ? sample : roundTripMilliseconds * 0.875f + sample * 0.125f;
+            }
             break;
 
         case MessageType::PLAYER_INPUT:
@@ -574,20 +616,25 @@ void NetworkSystem::processIncomingMessages(ECS &ecs, GameManager &gameManager)
                 memcpy(&removeData, message.data, sizeof(EntityRemoveData));
                 if (!isHost)
                 {
-                    std::string entityType(removeData.entityType);
-                    std::cout << "[CLIENT] Removing " << entityType << " entity with network ID:" << removeData.entityID << std::endl;
+                    removeNetworkEntity(ecs, removeData.entityID, removeData.entityType);
+                }
+            }
+        }
+        break;
 
-                    // Find the local entity ID using the mapping
-                    EntityID localEntityID = getLocalEntityID(removeData.entityID);
-                    if (localEntityID != 0)
-                    {
-                        std::cout << "[CLIENT] Found local entity ID " << localEntityID << " for network ID " << removeData.entityID << std::endl;
-                        ecs.removeEntity(localEntityID);
-                        unregisterNetworkEntity(removeData.entityID);
-                    }
-                    else
+        case MessageType::ENTITY_REMOVE_BATCH:
+        {
+            EntityRemoveBatchData batch;
+            if (message.dataSize >= sizeof(EntityRemoveBatchData))
+            {
+                memcpy(&batch, message.data, sizeof(EntityRemoveBatchData));
+                std::cout << "Received ENTITY_REMOVE_BATCH message (" << batch.count << " entities)" << std::endl;
+                if (!isHost)
+                {
+                    int count = std::min<int>(batch.count, EntityRemoveBatchData::MAX_ENTITIES);
+                    for (int i = 0; i < count; i++)
                     {
-                        std::cout << "[CLIENT] Warning: Could not find local entity for network ID " << removeData.entityID << std::endl;
+                        removeNetworkEntity(ecs, batch.entityIDs[i], removedEntityTypeName(batch.entityTypes[i]));
                     }
                 }
             }
@@ -618,8 +665,31 @@ void NetworkSystem::processIncomingMessages(ECS &ecs, GameManager &gameManager)
     }
 }
 
+void NetworkSystem::removeNetworkEntity(ECS &ecs, uint32_t networkID, const std::string &entityType)
+{
+    std::cout << "[CLIENT] Removing " << entityType << " entity with network ID:" << networkID << std::endl;
+
+    // Find the local entity ID using the mapping
+    EntityID localEntityID = getLocalEntityID(networkID);
+    if (localEntityID != 0)
+    {
+        std::cout << "[CLIENT] Found local entity ID " << localEntityID << " for network ID " << networkID << std::endl;
+        ecs.removeEntity(localEntityID);
+        unregisterNetworkEntity(networkID);
+    }
+    else
+    {
+        std::cout << "[CLIENT] Warning: Could not find local entity for network ID " << networkID << std::endl;
+    }
+}
+
 void NetworkSystem::processOutgoingMessages()
 {
+    PROFILE_SCOPE("network send");
+
+    sendPendingRemovals();
+
+    outgoingQueueDepth = outgoingMessages.size();
     while (!outgoingMessages.empty())
     {
         NetworkMessage message = outgoingMessages.front();
@@ -637,6 +707,14 @@ void NetworkSystem::processOutgoingMessages()
                 {
                     std::cerr << "Failed to send complete message" << std::endl;
                 }
+                else
+                {
+                    messagesSent++;
+                }
+                if (bytesSent > 0)
+                {
+                    sentBytes += static_cast<uint64_t>(bytesSent);
+                }
             }
         }
     }
@@ -719,7 +797,9 @@ bool NetworkSystem::deserializeMessage(const uint8_t *buffer, size_t bufferSize,
 
 uint32_t NetworkSystem::generatePlayerID()
 {
-    return SDL_GetTicks() + (rand() % 1000);
+    std::mt19937 generator(streamSeed(randomSeed, isHost ? "network.host" : "network.client"));
+    uint32_t id = generator();
+    return id != 0 ? id : 1; // 0 is the unset ID
 }
 
 void NetworkSystem::sendPlayerInput(float velocityX, float velocityY, int mouseX, int mouseY, bool shooting)
@@ -915,6 +995,36 @@ void NetworkSystem::sendEntityRemove(uint32_t entityID, const std::string &entit
     sendMessage(message);
 }
 
+void NetworkSystem::queueEntityRemove(uint32_t entityID, RemovedEntityType entityType)
+{
+    if (!isConnected())
+        return;
+
+    pendingRemovals.push_back({entityID, entityType});
+}
+
+void NetworkSystem::sendPendingRemovals()
+{
+    // Queued after everything else sent this frame, so a client never sees
+    // the removal of an entity before its creation
+    for (std::size_t first = 0; first < pendingRemovals.size(); first += EntityRemoveBatchData::MAX_ENTITIES)
+    {
+        EntityRemoveBatchData batch = {};
+        batch.count = static_cast<uint16_t>(std::min<std::size_t>(pendingRemovals.size() - first, EntityRemoveBatchData::MAX_ENTITIES));
+        for (int i = 0; i < batch.count; i++)
+        {
+            batch.entityIDs[i] = pendingRemovals[first + i].entityID;
+            batch.entityTypes[i] = static_cast<uint8_t>(pendingRemovals[first + i].entityType);
+        }
+
+        NetworkMessage message(MessageType::ENTITY_REMOVE_BATCH, localPlayerID);
+        message.dataSize = sizeof(EntityRemoveBatchData);
+        memcpy(message.data, &batch, sizeof(EntityRemoveBatchData));
+        sendMessage(message);
+    }
+    pendingRemovals.clear();
+}
+
 void NetworkSystem::sendGameOver()
 {
     if (!isConnected())
@@ -1005,29 +1115,45 @@ void NetworkSystem::sendLobbyStatus()
 // Entity ID mapping methods for network synchronization
 void NetworkSystem::registerNetworkEntity(uint32_t networkID, EntityID localID)
 {
-    networkToLocalEntityMap[networkID] = localID;
-    localToNetworkEntityMap[localID] = networkID;
+    uint32_t networkIndex = entityIndex(networkID);
+    uint32_t localIndex = entityIndex(localID);
+    if (networkIndex >= networkToLocalEntities.size())
+        networkToLocalEntities.resize(networkIndex + 1);
+    if (localIndex >= localToNetworkEntities.size())
+        localToNetworkEntities.resize(localIndex + 1);
+
+    networkToLocalEntities[networkIndex] = {networkID, localID};
+    localToNetworkEntities[localIndex] = {networkID, localID};
 }
 
 EntityID NetworkSystem::getLocalEntityID(uint32_t networkID)
 {
-    auto it = networkToLocalEntityMap.find(networkID);
-    return it != networkToLocalEntityMap.end() ? it->second : 0;
+    uint32_t networkIndex = entityIndex(networkID);
+    if (networkIndex >= networkToLocalEntities.size())
+        return NULL_ENTITY;
+
+    const EntityLink &link = networkToLocalEntities[networkIndex];
+    return link.networkID == networkID ? link.localID : NULL_ENTITY;
 }
 
 uint32_t NetworkSystem::getNetworkEntityID(EntityID localID)
 {
-    auto it = localToNetworkEntityMap.find(localID);
-    return it != localToNetworkEntityMap.end() ? it->second : 0;
+    uint32_t localIndex = entityIndex(localID);
+    if (localIndex >= localToNetworkEntities.size())
+        return 0;
+
+    const EntityLink &link = localToNetworkEntities[localIndex];
+    return link.localID == localID ? link.networkID : 0;
 }
 
 void NetworkSystem::unregisterNetworkEntity(uint32_t networkID)
 {
-    auto it = networkToLocalEntityMap.find(networkID);
-    if (it != networkToLocalEntityMap.end())
+    EntityID localID = getLocalEntityID(networkID);
+    if (localID != NULL_ENTITY)
     {
-        EntityID localID = it->second;
-        networkToLocalEntityMap.erase(it);
-        localToNetworkEntityMap.erase(localID);
+        networkToLocalEntities[entityIndex(networkID)] = EntityLink{};
+        EntityLink &localLink = localToNetworkEntities[entityIndex(localID)];
+        if (localLink.localID == localID)
+            localLink = EntityLink{};
     }
 }
@@ -6,7 +6,6 @@
 #include <string>
 #include <vector>
 #include <queue>
-#include <unordered_map>
 
 enum class MessageType : uint8_t
 {
@@ -38,7 +37,10 @@ enum class MessageType : uint8_t
 
     // Heartbeat
     PING,
-    PONG
+    PONG,
+
+    // Added after the original set so older peers keep the values above
+    ENTITY_REMOVE_BATCH // Every removal of one host frame in one message
 };
 
 struct NetworkMessage
@@ -144,6 +146,23 @@ struct EntityRemoveData
     uint32_t timestamp;
 };
 
+// Kinds of entity an ENTITY_REMOVE_BATCH entry can name
+enum class RemovedEntityType : uint8_t
+{
+    PROJECTILE,
+    MOB,
+    MOB_KING
+};
+
+struct EntityRemoveBatchData
+{
+    static constexpr int MAX_ENTITIES = 50; // fits the 256-byte message payload
+
+    uint16_t count;
+    uint8_t entityTypes[MAX_ENTITIES]; // RemovedEntityType
+    uint32_t entityIDs[MAX_ENTITIES];
+};
+
 struct ConnectionInfo
 {
     TCPsocket socket;
@@ -162,6 +181,7 @@ private:
     NetworkState currentState;
     bool isHost;
     uint32_t localPlayerID;
+    std::uint64_t randomSeed;
 
     // SDL_net objects
     TCPsocket serverSocket;
@@ -171,10 +191,35 @@ private:
     // Message handling
     std::queue<NetworkMessage> incomingMessages;
     std::queue<NetworkMessage> outgoingMessages;
-
-    // Entity ID mapping for network synchronization
-    std::unordered_map<uint32_t, EntityID> networkToLocalEntityMap; // networkID -> localEntityID
-    std::unordered_map<EntityID, uint32_t> localToNetworkEntityMap; // localEntityID -> networkID
+    uint32_t messagesReceived = 0; // since startup
+    uint32_t messagesSent = 0;
+    uint64_t receivedBytes = 0;
+    uint64_t sentBytes = 0;
+    size_t incomingQueueDepth = 0; // queue sizes when last drained
+    size_t outgoingQueueDepth = 0;
+
+    // Round trip of the heartbeat ping, smoothed like TCP's SRTT; 0 until
+    // the first pong of a connection arrives
+    float roundTripMilliseconds = 0.0f;
+
+    // Removals queued this frame, sent as ENTITY_REMOVE_BATCH messages
+    struct PendingRemoval
+    {
+        uint32_t entityID;
+        RemovedEntityType entityType;
+    };
+    std::vector<PendingRemoval> pendingRemovals;
+
+    // Entity ID mapping for network synchronization. Network IDs are the host's
+    // entity handles, so both directions are dense arrays indexed by
+    // entityIndex(); each link stores both full handles to reject recycled slots.
+    struct EntityLink
+    {
+        uint32_t networkID = 0;
+        EntityID localID = NULL_ENTITY;
+    };
+    std::vector<EntityLink> networkToLocalEntities; // entityIndex(networkID) -> link
+    std::vector<EntityLink> localToNetworkEntities; // entityIndex(localID) -> link
 
     // Configuration
     std::string hostIP;
@@ -235,6 +280,7 @@ public:
     void sendProjectileCreate(uint32_t projectileID, uint32_t shooterID, float x, float y, float velocityX, float velocityY, float damage, bool fromPlayer);
     void sendProjectileHit(uint32_t projectileID, uint32_t targetID, float damage, bool destroyed);
     void sendEntityRemove(uint32_t entityID, const std::string &entityType); // Step 3: Replace PROJECTILE_HIT with entity removal
+    void queueEntityRemove(uint32_t entityID, RemovedEntityType entityType); // batched, sent with the next outgoing messages
     void sendGameStart();
     void sendGameOver();
 
@@ -250,12 +296,23 @@ public:
     void setWeaponSystem(class WeaponSystem *system) { weaponSystem = system; }
     void setMovementSystem(class MovementSystem *system) { movementSystem = system; }
 
+    // Seed player IDs are drawn from; host and client use separate streams so
+    // two peers started with the same seed still get different IDs
+    void setRandomSeed(std::uint64_t masterSeed) { randomSeed = masterSeed; }
+
     // State queries
     NetworkState getState() const { return currentState; }
     bool isConnected() const;
     bool isHosting() const { return isHost; }
     uint32_t getLocalPlayerID() const { return localPlayerID; }
     uint32_t getRemotePlayerID() const { return remoteConnection.playerID; }
+    uint32_t getMessagesReceived() const { return messagesReceived; }
+    uint32_t getMessagesSent() const { return messagesSent; }
+    uint64_t getBytesReceived() const { return receivedBytes; }
+    uint64_t getBytesSent() const { return sentBytes; }
+    size_t getIncomingQueueDepth() const { return incomingQueueDepth; }
+    size_t getOutgoingQueueDepth() const { return outgoingQueueDepth; }
+    float getRoundTripMilliseconds() const { return roundTripMilliseconds; }
 
     // Debug control
     void setDebugMode(bool enable) { debugMode = enable; }
@@ -268,6 +325,8 @@ private:
     bool handleIncomingConnections();
     void processIncomingMessages(ECS &ecs, GameManager &gameManager);
     void processOutgoingMessages();
+    void sendPendingRemovals();
+    void removeNetworkEntity(ECS &ecs, uint32_t networkID, const std::string &entityType);
     void handleHeartbeat();
 
     // Message serialization
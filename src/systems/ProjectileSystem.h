@@ -4,6 +4,8 @@
 #include "../managers/GameManager.h"
 #include "../components/Components.h"
 
+// Moves projectiles and expires them. Their hits are found by CollisionSystem
+// and applied by DamageSystem.
 class ProjectileSystem : public System
 {
 private:
@@ -14,6 +16,7 @@ public:
     ~ProjectileSystem();
 
     void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
+    SystemAccess getAccess() const override;
 
     // Network synchronization
     void setNetworkSystem(class NetworkSystem *network) { networkSystem = network; }
@@ -21,8 +24,5 @@ public:
 private:
     void moveProjectiles(ECS &ecs, float deltaTime);
     void checkProjectileLifetime(ECS &ecs, float deltaTime);
-    void handleProjectileCollisions(ECS &ecs, GameManager &gameManager);
     void removeProjectile(ECS &ecs, EntityID entityID);
-    bool checkProjectileCollision(const Transform &projTransform, const Collider &projCollider,
-                                  const Transform &targetTransform, const Collider &targetCollider);
 };
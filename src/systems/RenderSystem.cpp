@@ -1,6 +1,8 @@
 #include "RenderSystem.h"
 #include "../components/Components.h"
 #include "../managers/ResourceManager.h"
+#include "../core/Profiler.h"
+#include <algorithm>
 #include <sstream>
 #include <cmath>
 
@@ -9,6 +11,8 @@ RenderSystem::RenderSystem(SDL_Renderer *renderer, ResourceManager *rm)
 
 void RenderSystem::update(ECS &ecs, GameManager &gameManager, float fps)
 {
+    PROFILE_SCOPE("render");
+
     // Clear screen with sky blue background (135, 206, 235)
     SDL_SetRenderDrawColor(renderer, 135, 206, 235, 255);
     SDL_RenderClear(renderer);
@@ -27,13 +31,27 @@ void RenderSystem::update(ECS &ecs, GameManager &gameManager, float fps)
 
     // Render UI
     renderUI(ecs, gameManager, fps);
+    renderDebugOverlay();
 
-    // Present frame
+    // Present frame (waits for vsync when the driver syncs)
+    PROFILE_SCOPE("present");
     SDL_RenderPresent(renderer);
 }
 
+float RenderSystem::renderX(const Transform &transform) const
+{
+    return transform.previousX + (transform.x - transform.previousX) * interpolationAlpha;
+}
+
+float RenderSystem::renderY(const Transform &transform) const
+{
+    return transform.previousY + (transform.y - transform.previousY) * interpolationAlpha;
+}
+
 void RenderSystem::renderSprites(ECS &ecs)
 {
+    PROFILE_SCOPE("render sprites");
+
     auto &transforms = ecs.getComponents<Transform>();
 
     for (auto &[entityID, transform] : transforms)
@@ -137,8 +155,8 @@ void RenderSystem::renderSprites(ECS &ecs)
                 SDL_QueryTexture(sprite->texture, nullptr, nullptr, &textureWidth, &textureHeight);
 
                 SDL_Rect destRect = {
-                    static_cast<int>(transform.x - sprite->width / 2),
-                    static_cast<int>(transform.y - sprite->height / 2),
+                    static_cast<int>(renderX(transform) - sprite->width / 2),
+                    static_cast<int>(renderY(transform) - sprite->height / 2),
                     sprite->width,
                     sprite->height};
 
@@ -197,6 +215,8 @@ void RenderSystem::renderSprites(ECS &ecs)
 
 void RenderSystem::renderUI(ECS &ecs, GameManager &gameManager, float fps)
 {
+    PROFILE_SCOPE("render UI");
+
     auto &uiPositions = ecs.getComponents<UIPosition>();
 
     for (auto &[entityID, uiPos] : uiPositions)
@@ -275,6 +295,61 @@ void RenderSystem::renderUI(ECS &ecs, GameManager &gameManager, float fps)
     }
 }
 
+void RenderSystem::renderDebugOverlay()
+{
+    if (debugOverlay.empty())
+    {
+        return;
+    }
+
+    const int fontSize = 14;
+    const int margin = 10;
+    const int padding = 6;
+    TTF_Font *font = resourceManager->getFont("fonts/Xolonium-Regular.ttf", fontSize);
+    if (!font)
+    {
+        font = resourceManager->loadFont("fonts/Xolonium-Regular.ttf", fontSize);
+    }
+    if (!font)
+    {
+        return;
+    }
+
+    int panelWidth = 0;
+    for (const std::string &line : debugOverlay)
+    {
+        int lineWidth;
+        TTF_SizeText(font, line.c_str(), &lineWidth, nullptr);
+        panelWidth = std::max(panelWidth, lineWidth);
+    }
+    int lineHeight = TTF_FontLineSkip(font);
+    int outputWidth, outputHeight;
+    SDL_GetRendererOutputSize(renderer, &outputWidth, &outputHeight);
+
+    SDL_Rect panel = {outputWidth - margin - panelWidth - 2 * padding, margin,
+                      panelWidth + 2 * padding, static_cast<int>(debugOverlay.size()) * lineHeight + 2 * padding};
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+    SDL_RenderFillRect(renderer, &panel);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    SDL_Color white = {255, 255, 255, 255};
+    for (std::size_t i = 0; i < debugOverlay.size(); i++)
+    {
+        SDL_Texture *lineTexture = resourceManager->createTextTexture(debugOverlay[i], font, white);
+        if (!lineTexture)
+        {
+            continue;
+        }
+
+        int lineWidth, lineHeightActual;
+        SDL_QueryTexture(lineTexture, nullptr, nullptr, &lineWidth, &lineHeightActual);
+        SDL_Rect destRect = {panel.x + padding, panel.y + padding + static_cast<int>(i) * lineHeight, lineWidth, lineHeightActual};
+        SDL_RenderCopy(renderer, lineTexture, nullptr, &destRect);
+        SDL_DestroyTexture(lineTexture);
+    }
+}
+
 std::vector<std::string> RenderSystem::wrapText(const std::string &text, TTF_Font *font, int maxWidth)
 {
     std::vector<std::string> lines;
@@ -327,6 +402,17 @@ void RenderSystem::renderAimingLines(ECS &ecs)
         if (!aimingLine.showLine)
             continue;
 
+        // The line starts at the player's position after this tick; move it
+        // with the player's sprite, which is drawn between ticks
+        float offsetX = 0.0f;
+        float offsetY = 0.0f;
+        Transform *transform = ecs.getComponent<Transform>(entityID);
+        if (transform)
+        {
+            offsetX = renderX(*transform) - transform->x;
+            offsetY = renderY(*transform) - transform->y;
+        }
+
         // Calculate direction and length
         float dirX = aimingLine.endX - aimingLine.startX;
         float dirY = aimingLine.endY - aimingLine.startY;
@@ -353,8 +439,8 @@ void RenderSystem::renderAimingLines(ECS &ecs)
         float currentDistance = 0.0f;
         while (currentDistance < length && currentDistance < aimingLine.maxRange)
         {
-            float x = aimingLine.startX + dirX * currentDistance;
-            float y = aimingLine.startY + dirY * currentDistance;
+            float x = aimingLine.startX + offsetX + dirX * currentDistance;
+            float y = aimingLine.startY + offsetY + dirY * currentDistance;
 
             // Draw a small circle (dot)
             SDL_Rect dotRect = {
@@ -370,6 +456,8 @@ void RenderSystem::renderAimingLines(ECS &ecs)
 
 void RenderSystem::renderProjectiles(ECS &ecs)
 {
+    PROFILE_SCOPE("render projectiles");
+
     auto &projectileTags = ecs.getComponents<ProjectileTag>();
 
     for (auto &[entityID, projectileTag] : projectileTags)
@@ -393,8 +481,8 @@ void RenderSystem::renderProjectiles(ECS &ecs)
 
             // Draw a small rectangle for the projectile
             SDL_Rect rect = {
-                static_cast<int>(transform->x - sprite->width / 2),
-                static_cast<int>(transform->y - sprite->height / 2),
+                static_cast<int>(renderX(*transform) - sprite->width / 2),
+                static_cast<int>(renderY(*transform) - sprite->height / 2),
                 sprite->width,
                 sprite->height};
             SDL_RenderFillRect(renderer, &rect);
@@ -7,22 +7,36 @@
 #include <string>
 
 class ResourceManager; // Forward declaration
+struct Transform;
 
 class RenderSystem : public System
 {
 private:
     SDL_Renderer *renderer;
     ResourceManager *resourceManager;
+    float interpolationAlpha = 1.0f;
+    std::vector<std::string> debugOverlay;
 
 public:
     RenderSystem(SDL_Renderer *renderer, ResourceManager *rm);
     void update(ECS &ecs, GameManager &gameManager, float fps);
 
+    // How far between each Transform's previous and current position to draw
+    // it (0..1); the simulation ticks at a fixed rate, independent of frames
+    void setInterpolationAlpha(float alpha) { interpolationAlpha = alpha; }
+
+    // Lines drawn in a panel in the top-right corner over everything else
+    // (the profiler's per-system times); empty hides the panel
+    void setDebugOverlay(std::vector<std::string> lines) { debugOverlay = std::move(lines); }
+
 private:
     void renderSprites(ECS &ecs);
+    float renderX(const Transform &transform) const;
+    float renderY(const Transform &transform) const;
     void renderUI(ECS &ecs, GameManager &gameManager, float fps);
     void renderAimingLines(ECS &ecs);
     void renderProjectiles(ECS &ecs);
     void renderCrosshair(ECS &ecs);
+    void renderDebugOverlay();
     std::vector<std::string> wrapText(const std::string &text, TTF_Font *font, int maxWidth);
 };
@@ -1,5 +1,7 @@
 #pragma once
 #include "../core/ECS.h"
+#include "../core/SystemScheduler.h"
+#include "../core/JobSystem.h"
 #include <SDL2/SDL.h>
 #include <chrono>
 
@@ -14,4 +16,8 @@ public:
     virtual void update(ECS &ecs, float deltaTime) {}
     virtual void update(ECS &ecs, GameManager &gameManager) {}
     virtual void update(ECS &ecs, GameManager &gameManager, float deltaTime) {}
+
+    // Data touched by update(), used by SystemScheduler to find systems that
+    // can run concurrently. Systems that don't declare it run exclusively.
+    virtual SystemAccess getAccess() const { return SystemAccess::exclusive(); }
 };
@@ -9,7 +9,9 @@
 #include "RenderSystem.h"
 #include "AudioSystem.h"
 #include "MobSpawningSystem.h"
+#include "BroadphaseSystem.h"
 #include "CollisionSystem.h"
+#include "DamageSystem.h"
 #include "BoundarySystem.h"
 #include "AimingSystem.h"
 #include "WeaponSystem.h"
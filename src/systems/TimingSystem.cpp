@@ -1,19 +1,37 @@
 #include "TimingSystem.h"
+#include "../core/Profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <string>
 #include <thread>
 
 TimingSystem::TimingSystem()
     : frameCount(0), currentFPS(60.0f)
 {
-    lastTime = std::chrono::high_resolution_clock::now();
+    lastTime = Clock::now();
     fpsCounterTime = lastTime;
+    frameDeadline = lastTime;
+    frameTimes.reserve(FRAME_HISTORY);
+    setFrameLimit(60, 2000);
 }
 
 float TimingSystem::update()
 {
-    auto currentTime = std::chrono::high_resolution_clock::now();
+    auto currentTime = Clock::now();
     auto deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
     lastTime = currentTime;
 
+    // Record the frame time, replacing the oldest once the history is full
+    if (frameTimes.size() < FRAME_HISTORY)
+    {
+        frameTimes.push_back(deltaTime);
+    }
+    else
+    {
+        frameTimes[nextFrameSlot] = deltaTime;
+    }
+    nextFrameSlot = (nextFrameSlot + 1) % FRAME_HISTORY;
+
     // Update FPS counter
     frameCount++;
     auto fpsElapsed = std::chrono::duration<float>(currentTime - fpsCounterTime).count();
@@ -27,14 +45,133 @@ float TimingSystem::update()
     return deltaTime;
 }
 
+void TimingSystem::setTickRate(float ticksPerSecond, int maxTicks)
+{
+    fixedDeltaTime = 1.0f / (ticksPerSecond > 1.0f ? ticksPerSecond : 1.0f);
+    maxTicksPerFrame = maxTicks > 1 ? maxTicks : 1;
+    accumulator = 0.0f;
+}
+
+void TimingSystem::accumulate(float frameTime)
+{
+    accumulator = std::min(accumulator + frameTime, fixedDeltaTime * maxTicksPerFrame);
+}
+
+bool TimingSystem::consumeTick()
+{
+    if (accumulator < fixedDeltaTime)
+    {
+        return false;
+    }
+
+    accumulator -= fixedDeltaTime;
+    return true;
+}
+
+void TimingSystem::setFrameLimit(int targetFPS, int spinMicroseconds)
+{
+    targetFramePeriod = targetFPS > 0 ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFPS))
+                                      : Clock::duration::zero();
+    spinMargin = std::chrono::microseconds(std::max(spinMicroseconds, 0));
+    frameDeadline = Clock::now();
+}
+
 void TimingSystem::limitFrameRate()
 {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    auto frameTime = std::chrono::duration<float>(currentTime - lastTime).count();
+    PROFILE_SCOPE("frame limiter");
+
+    if (targetFramePeriod == Clock::duration::zero())
+    {
+        return;
+    }
 
-    if (frameTime < targetFrameTime)
+    auto currentTime = Clock::now();
+    frameDeadline += targetFramePeriod;
+    if (currentTime >= frameDeadline)
     {
-        float sleepTime = targetFrameTime - frameTime;
-        std::this_thread::sleep_for(std::chrono::duration<float>(sleepTime));
+        // Late; after a long hitch, pace from now rather than rushing frames
+        // out to catch up with the old schedule
+        if (currentTime - frameDeadline > targetFramePeriod)
+        {
+            frameDeadline = currentTime;
+        }
+        return;
+    }
+
+    // Sleeping can overshoot, so stop short of the deadline and spin the rest
+    auto spinStart = frameDeadline - spinMargin;
+    if (currentTime < spinStart)
+    {
+        std::this_thread::sleep_until(spinStart);
+    }
+    while (Clock::now() < frameDeadline)
+    {
+        std::this_thread::yield();
+    }
+}
+
+FrameTimeStats TimingSystem::getFrameTimeStats() const
+{
+    FrameTimeStats stats;
+    if (frameTimes.empty())
+    {
+        return stats;
+    }
+
+    std::vector<float> sorted(frameTimes);
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](float fraction)
+    {
+        std::size_t index = static_cast<std::size_t>(fraction * (sorted.size() - 1) + 0.5f);
+        return sorted[index] * 1000.0f;
+    };
+
+    float total = 0.0f;
+    for (float frameTime : sorted)
+    {
+        total += frameTime;
+    }
+
+    stats.frames = sorted.size();
+    stats.average = total / sorted.size() * 1000.0f;
+    stats.p50 = percentile(0.50f);
+    stats.p95 = percentile(0.95f);
+    stats.p99 = percentile(0.99f);
+    stats.max = sorted.back() * 1000.0f;
+    return stats;
+}
+
+void TimingSystem::dumpFrameTimes(std::ostream &out) const
+{
+    FrameTimeStats stats = getFrameTimeStats();
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision();
+    out << std::fixed << std::setprecision(2)
+        << "Frame times over the last " << stats.frames << " frames (ms): avg " << stats.average
+        << ", p50 " << stats.p50 << ", p95 " << stats.p95 << ", p99 " << stats.p99
+        << ", max " << stats.max << std::endl;
+
+    // 1 ms buckets; everything from the last bucket up is lumped together
+    const int bucketCount = 34;
+    std::vector<std::size_t> buckets(bucketCount, 0);
+    std::size_t largest = 0;
+    for (float frameTime : frameTimes)
+    {
+        int bucket = std::min(static_cast<int>(frameTime * 1000.0f), bucketCount - 1);
+        largest = std::max(largest, ++buckets[bucket]);
+    }
+
+    for (int bucket = 0; bucket < bucketCount; bucket++)
+    {
+        if (buckets[bucket] == 0)
+        {
+            continue;
+        }
+
+        std::size_t barLength = (buckets[bucket] * 50 + largest - 1) / largest;
+        out << std::setw(3) << bucket << (bucket == bucketCount - 1 ? "+ ms " : "  ms ")
+            << std::setw(5) << buckets[bucket] << " " << std::string(barLength, '#') << std::endl;
     }
+    out.flags(flags);
+    out.precision(precision);
 }
@@ -1,16 +1,47 @@
 #pragma once
 #include "System.h"
 #include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// Summary of the recent frame times, in milliseconds
+struct FrameTimeStats
+{
+    std::size_t frames = 0;
+    float average = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
 
 class TimingSystem : public System
 {
 private:
-    std::chrono::high_resolution_clock::time_point lastTime;
-    std::chrono::high_resolution_clock::time_point fpsCounterTime;
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point lastTime;
+    Clock::time_point fpsCounterTime;
     int frameCount;
     float currentFPS;
-    const float targetFPS = 60.0f;
-    const float targetFrameTime = 1.0f / targetFPS;
+
+    // Frame pacing: each frame ends at a deadline one period after the last,
+    // so small overshoots don't add up. 0 means uncapped.
+    Clock::duration targetFramePeriod;
+    Clock::duration spinMargin;
+    Clock::time_point frameDeadline;
+
+    // The last FRAME_HISTORY frame times in seconds, oldest overwritten first
+    static constexpr std::size_t FRAME_HISTORY = 1024;
+    std::vector<float> frameTimes;
+    std::size_t nextFrameSlot = 0;
+
+    // Fixed simulation step: real frame time is banked in the accumulator
+    // and spent one tick at a time
+    float fixedDeltaTime = 1.0f / 60.0f;
+    int maxTicksPerFrame = 5;
+    float accumulator = 0.0f;
 
 public:
     TimingSystem();
@@ -18,12 +49,37 @@ public:
     // Returns delta time in seconds
     float update();
 
-    // Limit frame rate to 60 FPS
+    // Simulation ticks per second, and the most ticks one frame may run
+    // before the rest of a long frame is dropped (so a stall can't snowball)
+    void setTickRate(float ticksPerSecond, int maxTicks);
+    float getFixedDeltaTime() const { return fixedDeltaTime; }
+
+    // Banks a frame's real time for the simulation
+    void accumulate(float frameTime);
+
+    // True while a whole tick is banked; each call that returns true spends it
+    bool consumeTick();
+
+    // How far the banked remainder is into the next tick (0..1): where
+    // rendering sits between the previous and the current simulation state
+    float getInterpolationAlpha() const { return accumulator / fixedDeltaTime; }
+
+    // Frames per second limitFrameRate() holds to; 0 or less leaves the frame
+    // rate uncapped. The last spinMicroseconds before each frame's deadline
+    // are spun instead of slept, since a sleep can wake late by about that much.
+    void setFrameLimit(int targetFPS, int spinMicroseconds);
+
+    // Waits out the rest of the frame: a coarse sleep, then a yield loop up
+    // to the deadline
     void limitFrameRate();
 
     // Get current FPS for display
     float getFPS() const { return currentFPS; }
 
-    // Get target frame time
-    float getTargetFrameTime() const { return targetFrameTime; }
+    // Get target frame time (0 when uncapped)
+    float getTargetFrameTime() const { return std::chrono::duration<float>(targetFramePeriod).count(); }
+
+    // Percentiles of the recent frame times, and a printable histogram of them
+    FrameTimeStats getFrameTimeStats() const;
+    void dumpFrameTimes(std::ostream &out) const;
 };
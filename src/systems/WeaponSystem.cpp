@@ -1,9 +1,11 @@
 #include "WeaponSystem.h"
 #include "NetworkSystem.h"
+#include "../physics/SweptAABB.h"
 #include "../components/Components.h"
 #include <SDL2/SDL.h>
 #include <cmath>
 #include <iostream>
+#include <algorithm>
 
 WeaponSystem::WeaponSystem(EntityFactory *factory, AudioSystem *audio) : entityFactory(factory), audioSystem(audio)
 {
@@ -13,8 +15,25 @@ WeaponSystem::~WeaponSystem()
 {
 }
 
+SystemAccess WeaponSystem::getAccess() const
+{
+    // Spawns projectiles directly, so it is a structural writer. Hitscan
+    // shots are cast against the broadphase and join the frame's contacts.
+    return SystemAccess()
+        .read<MobKing, MobTag, PlayerTag, MouseTarget, MovementDirection, Transform, Velocity, Collider>()
+        .write<Weapon>()
+        .read(SystemResource::GameState)
+        .read(SystemResource::Input)
+        .read(SystemResource::Broadphase)
+        .write(SystemResource::Contacts)
+        .write(SystemResource::Structural)
+        .write(SystemResource::Audio)
+        .write(SystemResource::Network);
+}
+
 void WeaponSystem::update(ECS &ecs, GameManager &gameManager, float deltaTime)
 {
+    hitscanHits.clear();
     updateWeaponTimers(ecs, deltaTime);
 
     // In multiplayer mode, shooting logic depends on role:
@@ -106,9 +125,8 @@ void WeaponSystem::handlePlayerShooting(ECS &ecs, GameManager &gameManager, floa
             dirY /= length;
         }
 
-        // Create projectile
-        EntityID projectileEntity = createProjectile(ecs, gameManager, transform->x, transform->y,
-                                                     dirX, dirY, *weapon, entityID, 500.0f, true);
+        // Fire a projectile (or a hitscan shot)
+        fireShot(ecs, gameManager, transform->x, transform->y, dirX, dirY, *weapon, entityID, 500.0f, true);
 
         // Play gun shot sound
         if (audioSystem)
@@ -127,6 +145,54 @@ void WeaponSystem::handlePlayerShooting(ECS &ecs, GameManager &gameManager, floa
     }
 }
 
+void WeaponSystem::fireShot(ECS &ecs, GameManager &gameManager, float startX, float startY, float dirX, float dirY,
+                            const Weapon &weapon, EntityID owner, float projectileSpeed, bool isPlayerProjectile)
+{
+    // Hits are resolved where damage is applied, so a multiplayer client
+    // still sends its shots to the host as projectiles
+    bool appliesDamage = !(gameManager.isMultiplayer() && networkSystem && !networkSystem->isHosting());
+    if (!weapon.hitscan || !appliesDamage)
+    {
+        createProjectile(ecs, gameManager, startX, startY, dirX, dirY, weapon, owner, projectileSpeed, isPlayerProjectile);
+        return;
+    }
+
+    // One query instead of a projectile entity and its create/remove messages
+    std::uint32_t shotLayer = isPlayerProjectile ? CollisionLayer::PLAYER_BULLET : CollisionLayer::MOB_BULLET;
+    RaycastHit hit;
+    if (raycastBodies(ecs, Ray{startX, startY, dirX, dirY, weapon.range}, CollisionLayer::maskFor(shotLayer), hit))
+    {
+        std::uint32_t targetLayer = ecs.getComponent<Collider>(hit.entity)->layer;
+        hitscanHits.push_back({owner, hit.entity, shotLayer | targetLayer, weapon.damage});
+    }
+}
+
+bool WeaponSystem::raycastBodies(ECS &ecs, const Ray &ray, std::uint32_t mask, RaycastHit &hit) const
+{
+    if (broadphase)
+    {
+        return broadphase->raycast(ray, mask, hit, [&ecs](EntityID entity)
+                                   { return !ecs.isPendingRemoval(entity); });
+    }
+
+    // No spatial index: test every body
+    bool found = false;
+    ecs.view<Transform, Collider>().each([&](EntityID entityID, Transform &transform, Collider &collider)
+    {
+        float halfWidth = collider.width / 2.0f;
+        float halfHeight = collider.height / 2.0f;
+        AABB bounds{transform.x - halfWidth, transform.y - halfHeight, transform.x + halfWidth, transform.y + halfHeight};
+        float distance;
+        if ((collider.layer & mask) != 0 && raycastAABB(ray, bounds, distance) && (!found || distance < hit.distance))
+        {
+            hit.entity = entityID;
+            hit.distance = distance;
+            found = true;
+        }
+    });
+    return found;
+}
+
 EntityID WeaponSystem::createProjectile(ECS &ecs, GameManager &gameManager, float startX, float startY,
                                         float dirX, float dirY, const Weapon &weapon, EntityID owner, float projectileSpeed, bool isPlayerProjectile)
 {
@@ -149,14 +215,14 @@ EntityID WeaponSystem::createProjectile(ECS &ecs, GameManager &gameManager, floa
         // Player projectiles: small, white/yellow
         ecs.addComponent(projectileEntity, Sprite(nullptr, 4, 4, 1, 0.0f));
         ecs.addComponent(projectileEntity, ProjectileColor(SDL_Color{255, 255, 0, 255})); // Yellow
-        ecs.addComponent(projectileEntity, Collider(4.0f, 4.0f, false));
+        ecs.addComponent(projectileEntity, Collider(4.0f, 4.0f, false, CollisionLayer::PLAYER_BULLET));
     }
     else
     {
         // Mob projectiles: larger, red
         ecs.addComponent(projectileEntity, Sprite(nullptr, 8, 8, 1, 0.0f));
         ecs.addComponent(projectileEntity, ProjectileColor(SDL_Color{255, 0, 0, 255})); // Red
-        ecs.addComponent(projectileEntity, Collider(8.0f, 8.0f, false));
+        ecs.addComponent(projectileEntity, Collider(8.0f, 8.0f, false, CollisionLayer::MOB_BULLET));
     }
 
     // Send projectile data over network for multiplayer synchronization
@@ -206,14 +272,12 @@ void WeaponSystem::handleMobKingShooting(ECS &ecs, GameManager &gameManager, flo
         if (!weapon->canFire)
             continue;
 
-        // Get keyboard state to check for shooting key
-        const Uint8 *keyboardState = SDL_GetKeyboardState(nullptr);
         bool shouldShoot = false;
 
         if (gameManager.isMultiplayer())
         {
             // In multiplayer, check if SPACE key is pressed (like local mode) AND timer allows it
-            bool spacePressed = keyboardState[SDL_SCANCODE_SPACE];
+            bool spacePressed = isKeyDown(SDL_SCANCODE_SPACE);
             bool timerReady = weapon->canFire;
             shouldShoot = spacePressed && timerReady;
 
@@ -225,7 +289,7 @@ void WeaponSystem::handleMobKingShooting(ECS &ecs, GameManager &gameManager, flo
         else
         {
             // In local dual player mode, check P key directly AND timer
-            bool pPressed = keyboardState[SDL_SCANCODE_P];
+            bool pPressed = isKeyDown(SDL_SCANCODE_P);
             bool timerReady = weapon->canFire;
             shouldShoot = pPressed && timerReady;
 
@@ -270,9 +334,8 @@ void WeaponSystem::handleMobKingShooting(ECS &ecs, GameManager &gameManager, flo
             }
         }
 
-        // Create projectile in facing direction
-        EntityID projectileEntity = createProjectile(ecs, gameManager, transform->x, transform->y,
-                                                     dirX, dirY, *weapon, mobKingEntityID, 400.0f, false);
+        // Fire in facing direction
+        fireShot(ecs, gameManager, transform->x, transform->y, dirX, dirY, *weapon, mobKingEntityID, 400.0f, false);
 
         // Update weapon state - use JSON config fire rate (2.0 = 0.5s between shots)
         weapon->fireTimer = 1.0f / weapon->fireRate; // Time between shots from config
@@ -307,38 +370,58 @@ void WeaponSystem::handleRegularMobShooting(ECS &ecs, float deltaTime, GameManag
     if (!playerFound)
         return;
 
-    // Check all mobs with weapons (excluding Mob King)
-    auto &mobTags = ecs.getComponents<MobTag>();
-    for (auto &[mobEntityID, mobTag] : mobTags)
+    // Range checks only read, so they run in parallel and collect the mobs
+    // that should fire per thread; projectiles are then created here
+    PerThread<std::vector<MobShot>> shotLists(jobSystem);
+    auto checkRange = [&](EntityID mobEntityID, MobTag &, Weapon &weapon, Transform &transform)
     {
         // Skip if this is a Mob King (they have separate handling)
-        if (ecs.getComponent<MobKing>(mobEntityID))
-            continue;
-
-        Weapon *weapon = ecs.getComponent<Weapon>(mobEntityID);
-        Transform *transform = ecs.getComponent<Transform>(mobEntityID);
-
-        if (!weapon || !transform)
-            continue;
-        if (!weapon->canFire)
-            continue;
+        if (ecs.hasComponents<MobKing>(mobEntityID))
+            return;
+        if (!weapon.canFire)
+            return;
 
         // Calculate distance to player
-        float distX = playerX - transform->x;
-        float distY = playerY - transform->y;
+        float distX = playerX - transform.x;
+        float distY = playerY - transform.y;
         float distance = std::sqrt(distX * distX + distY * distY);
 
         // Only shoot if player is within range
-        if (distance > weapon->range)
-            continue;
+        if (distance > weapon.range)
+            return;
 
         // Calculate direction to player
-        float dirX = distX / distance;
-        float dirY = distY / distance;
+        shotLists.local().push_back({mobEntityID, distX / distance, distY / distance, distance});
+    };
+
+    // Check all mobs with weapons (excluding Mob King)
+    auto armedMobs = ecs.view<MobTag, Weapon, Transform>();
+    if (jobSystem)
+    {
+        jobSystem->parallelForEach(armedMobs, 4, checkRange);
+    }
+    else
+    {
+        armedMobs.each(checkRange);
+    }
+
+    std::vector<MobShot> shots;
+    for (std::size_t i = 0; i < shotLists.size(); i++)
+    {
+        shots.insert(shots.end(), shotLists[i].begin(), shotLists[i].end());
+    }
+
+    // Fire in handle order so the outcome doesn't depend on the thread count
+    std::sort(shots.begin(), shots.end(), [](const MobShot &a, const MobShot &b)
+              { return a.mob < b.mob; });
+
+    for (const MobShot &shot : shots)
+    {
+        Weapon *weapon = ecs.getComponent<Weapon>(shot.mob);
+        Transform *transform = ecs.getComponent<Transform>(shot.mob);
 
-        // Create projectile targeting player
-        EntityID projectileEntity = createProjectile(ecs, gameManager, transform->x, transform->y,
-                                                     dirX, dirY, *weapon, mobEntityID, 300.0f, false);
+        // Fire at the player
+        fireShot(ecs, gameManager, transform->x, transform->y, shot.dirX, shot.dirY, *weapon, shot.mob, 300.0f, false);
 
         // Update weapon state - use different fire rates for dual/multiplayer
         if (gameManager.isDualPlayer())
@@ -351,15 +434,13 @@ void WeaponSystem::handleRegularMobShooting(ECS &ecs, float deltaTime, GameManag
         }
         weapon->canFire = false;
 
-        std::cout << "Regular mob fired at player! Distance: " << distance << std::endl;
+        std::cout << "Regular mob fired at player! Distance: " << shot.distance << std::endl;
     }
 }
 
-bool WeaponSystem::isMousePressed()
+bool WeaponSystem::isMousePressed() const
 {
-    int mouseX, mouseY;
-    Uint32 mouseState = SDL_GetMouseState(&mouseX, &mouseY);
-    return (mouseState & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0;
+    return input && input->isMouseButtonDown(SDL_BUTTON_LEFT);
 }
 
 EntityID WeaponSystem::createProjectileFromNetwork(ECS &ecs, uint32_t projectileID, uint32_t shooterID, float x, float y, float velocityX, float velocityY, float damage, bool fromPlayer)
@@ -390,14 +471,14 @@ EntityID WeaponSystem::createProjectileFromNetwork(ECS &ecs, uint32_t projectile
         // Player projectiles: small, white/yellow
         ecs.addComponent(projectileEntity, Sprite(nullptr, 4, 4, 1, 0.0f));
         ecs.addComponent(projectileEntity, ProjectileColor(SDL_Color{255, 255, 0, 255})); // Yellow
-        ecs.addComponent(projectileEntity, Collider(4.0f, 4.0f, false));
+        ecs.addComponent(projectileEntity, Collider(4.0f, 4.0f, false, CollisionLayer::PLAYER_BULLET));
     }
     else
     {
         // Mob projectiles: larger, red
         ecs.addComponent(projectileEntity, Sprite(nullptr, 8, 8, 1, 0.0f));
         ecs.addComponent(projectileEntity, ProjectileColor(SDL_Color{255, 0, 0, 255})); // Red
-        ecs.addComponent(projectileEntity, Collider(8.0f, 8.0f, false));
+        ecs.addComponent(projectileEntity, Collider(8.0f, 8.0f, false, CollisionLayer::MOB_BULLET));
     }
 
     std::cout << "Network projectile created successfully!" << std::endl;
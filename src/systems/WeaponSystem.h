@@ -3,7 +3,21 @@
 #include "../core/ECS.h"
 #include "../managers/GameManager.h"
 #include "../managers/EntityFactory.h"
+#include "../core/InputFrame.h"
 #include "../systems/AudioSystem.h"
+#include "../physics/Broadphase.h"
+#include <vector>
+
+// A hitscan shot that reached a body this frame. `layers` is the shot's
+// bullet layer OR'ed with the target's, as in Contact, so DamageSystem
+// applies it like the bullet hit it replaces.
+struct HitscanHit
+{
+    EntityID shooter;
+    EntityID target;
+    std::uint32_t layers;
+    float damage;
+};
 
 class WeaponSystem : public System
 {
@@ -11,16 +25,41 @@ private:
     EntityFactory *entityFactory;
     AudioSystem *audioSystem;
     class NetworkSystem *networkSystem = nullptr; // Forward declaration
+    JobSystem *jobSystem = nullptr;
+    const Broadphase *broadphase = nullptr;
+    const InputFrame *input = nullptr;
+    std::vector<HitscanHit> hitscanHits;
+
+    // A mob whose player is in range, found during the parallel range checks
+    struct MobShot
+    {
+        EntityID mob;
+        float dirX, dirY;
+        float distance;
+    };
 
 public:
     WeaponSystem(EntityFactory *factory, AudioSystem *audio);
     ~WeaponSystem();
 
     void update(ECS &ecs, GameManager &gameManager, float deltaTime) override;
+    SystemAccess getAccess() const override;
 
     // Network synchronization
     void setNetworkSystem(class NetworkSystem *network) { networkSystem = network; }
 
+    // Splits mob range checks across worker threads when set
+    void setJobSystem(JobSystem *jobs) { jobSystem = jobs; }
+
+    // Hitscan rays are cast against it when set; otherwise against every body
+    void setBroadphase(const Broadphase *spatialIndex) { broadphase = spatialIndex; }
+
+    // This tick's keyboard and mouse state, captured or replayed by Game
+    void setInput(const InputFrame *frame) { input = frame; }
+
+    // This frame's hitscan hits, in firing order
+    const std::vector<HitscanHit> &getHitscanHits() const { return hitscanHits; }
+
     // Create projectile from network data (for Client synchronization)
     EntityID createProjectileFromNetwork(ECS &ecs, uint32_t projectileID, uint32_t shooterID, float x, float y, float velocityX, float velocityY, float damage, bool fromPlayer);
 
@@ -31,6 +70,9 @@ private:
     void handleRegularMobShooting(ECS &ecs, float deltaTime, GameManager &gameManager);
     void ensureMobsHaveWeapons(ECS &ecs, GameManager &gameManager);
     void updateWeaponTimers(ECS &ecs, float deltaTime);
+    void fireShot(ECS &ecs, GameManager &gameManager, float startX, float startY, float dirX, float dirY, const Weapon &weapon, EntityID owner, float projectileSpeed, bool isPlayerProjectile);
+    bool raycastBodies(ECS &ecs, const Ray &ray, std::uint32_t mask, RaycastHit &hit) const;
     EntityID createProjectile(ECS &ecs, GameManager &gameManager, float startX, float startY, float dirX, float dirY, const Weapon &weapon, EntityID owner, float projectileSpeed = 500.0f, bool isPlayerProjectile = true);
-    bool isMousePressed();
+    bool isMousePressed() const;
+    bool isKeyDown(SDL_Scancode key) const { return input && input->isKeyDown(key); }
 };